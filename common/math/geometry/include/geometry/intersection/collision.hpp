@@ -19,15 +19,35 @@
 #include <geometry/polygon/polygon.hpp>
 #include <geometry_msgs/msg/pose.hpp>
 #include <traffic_simulator_msgs/msg/bounding_box.hpp>
+#include <utility>
 #include <vector>
 
 namespace math
 {
 namespace geometry
 {
+/**
+ * @brief Check whether two bounding boxes overlap, using the separating axis theorem.
+ * @param pose0 pose of the first bounding box
+ * @param bbox0 size of the first bounding box
+ * @param pose1 pose of the second bounding box
+ * @param bbox1 size of the second bounding box
+ * @return true if the 2D footprints of the bounding boxes touch or overlap and their heights overlap
+ */
 bool checkCollision2D(
-  geometry_msgs::msg::Pose pose0, traffic_simulator_msgs::msg::BoundingBox bbox0,
-  geometry_msgs::msg::Pose pose1, traffic_simulator_msgs::msg::BoundingBox bbox1);
+  const geometry_msgs::msg::Pose & pose0, const traffic_simulator_msgs::msg::BoundingBox & bbox0,
+  const geometry_msgs::msg::Pose & pose1, const traffic_simulator_msgs::msg::BoundingBox & bbox1);
+/**
+ * @brief Find all pairs of bounding boxes which collide with each other.
+ *        Candidate pairs are selected by sweep and prune over the axis aligned bounding boxes
+ *        and then tested with the same check as checkCollision2D.
+ * @param poses poses of the bounding boxes
+ * @param bboxes sizes of the bounding boxes, same length as poses
+ * @return index pairs (i, j) with i < j, sorted in ascending order
+ */
+std::vector<std::pair<std::size_t, std::size_t>> getCollidingPairs2D(
+  const std::vector<geometry_msgs::msg::Pose> & poses,
+  const std::vector<traffic_simulator_msgs::msg::BoundingBox> & bboxes);
 bool contains(
   const std::vector<geometry_msgs::msg::Point> & polygon, const geometry_msgs::msg::Point & point);
 }  // namespace geometry
@@ -57,6 +57,25 @@ public:
   auto solveCubicEquation(
     const double a, const double b, const double c, const double d, const double min_value = 0,
     const double max_value = 1) const -> std::vector<double>;
+  /**
+   * @brief solve polynomial equation c[0] + c[1]*t + ... + c[n]*t^n = 0 of any degree numerically.
+   * Roots of the polynomial are isolated between the roots of its derivative (found recursively),
+   * so each interval between them contains at most one root, which is found by bisection.
+   *
+   * @param coefficients coefficients of the polynomial in ascending order of degree
+   * @return std::vector<double> real solution of the polynomial (from min_value to max_value) in ascending order
+   */
+  auto solvePolynomialEquation(
+    const std::vector<double> & coefficients, const double min_value = 0,
+    const double max_value = 1) const -> std::vector<double>;
+  /**
+   * @brief calculate result of polynomial function c[0] + c[1]*t + ... + c[n]*t^n
+   *
+   * @param coefficients coefficients of the polynomial in ascending order of degree
+   * @param t
+   * @return double result of polynomial function
+   */
+  auto polynomial(const std::vector<double> & coefficients, const double t) const -> double;
   /**
    * @brief calculate result of linear function a*t + b
    *
@@ -52,6 +52,13 @@ public:
   std::optional<double> getCollisionPointIn2D(
     const std::vector<geometry_msgs::msg::Point> & polygon, bool search_backward = false,
     bool close_start_end = true) const override;
+  /**
+   * @brief Find the first (or last, if search_backward) collision point in [start_s, end_s].
+   * @note Only the curves overlapping [start_s, end_s] are checked.
+   */
+  std::optional<double> getCollisionPointIn2D(
+    const std::vector<geometry_msgs::msg::Point> & polygon, double start_s, double end_s,
+    bool search_backward, bool close_start_end) const;
   const geometry_msgs::msg::Point getRightBoundsPoint(
     double width, double s, double z_offset = 0) const;
   const geometry_msgs::msg::Point getLeftBoundsPoint(
@@ -72,7 +79,8 @@ private:
 
   std::vector<HermiteCurve> curves_;
   std::vector<double> length_list_;
-  std::vector<double> maximum_2d_curvatures_;
+  /// @note Computed on demand, because most splines are only used for position queries.
+  mutable std::optional<double> maximum_2d_curvature_;
   double total_length_;
 };
 }  // namespace geometry
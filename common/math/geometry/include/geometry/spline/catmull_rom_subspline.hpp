@@ -29,11 +29,16 @@ namespace math
 {
 namespace geometry
 {
+/**
+ * @brief Non-owning view of the [start_s, end_s] part of a CatmullRomSpline.
+ * @note The viewed spline must outlive this object. Queries only visit the curves overlapping
+ * [start_s, end_s], so they cost proportional to the length of the window, not of the spline.
+ */
 class CatmullRomSubspline : public CatmullRomSplineInterface
 {
 public:
   explicit CatmullRomSubspline(
-    std::shared_ptr<math::geometry::CatmullRomSpline> spline, double start_s, double end_s)
+    const math::geometry::CatmullRomSpline & spline, double start_s, double end_s)
   : spline_(spline), start_s_(start_s), end_s_(end_s)
   {
   }
@@ -45,7 +50,7 @@ public:
     bool close_start_end = true) const override;
 
 private:
-  std::shared_ptr<math::geometry::CatmullRomSpline> spline_;
+  const math::geometry::CatmullRomSpline & spline_;
   double start_s_;
   double end_s_;
 };
@@ -63,12 +63,15 @@ public:
     const geometry_msgs::msg::Point & point, double s, bool autoscale = false) const;
   geometry_msgs::msg::Vector3 getSquaredDistanceVector(
     const geometry_msgs::msg::Point & point, double s, bool autoscale = false) const;
+  /**
+   * @note Only collision points in [min_value, max_value] are returned.
+   */
   std::optional<double> getCollisionPointIn2D(
     const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
-    bool search_backward = false) const;
+    bool search_backward = false, double min_value = 0, double max_value = 1) const;
   std::optional<double> getCollisionPointIn2D(
     const std::vector<geometry_msgs::msg::Point> & polygon, bool search_backward = false,
-    bool close_start_end = true) const;
+    bool close_start_end = true, double min_value = 0, double max_value = 1) const;
 
 private:
   std::pair<double, double> get2DMinMaxCurvatureValue() const;
@@ -12,42 +12,177 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <quaternion_operation/quaternion_operation.h>
-
-#include <boost/assert.hpp>
-#include <boost/assign/list_of.hpp>
 #include <boost/geometry.hpp>
-#include <boost/geometry/algorithms/disjoint.hpp>
-#include <boost/geometry/geometries/linestring.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
-#include <geometry/bounding_box.hpp>
+#include <algorithm>
+#include <cmath>
 #include <geometry/intersection/collision.hpp>
+#include <numeric>
+#include <scenario_simulator_exception/exception.hpp>
+#include <utility>
 #include <vector>
 
 namespace math
 {
 namespace geometry
 {
-bool checkCollision2D(
-  geometry_msgs::msg::Pose pose0, traffic_simulator_msgs::msg::BoundingBox bbox0,
-  geometry_msgs::msg::Pose pose1, traffic_simulator_msgs::msg::BoundingBox bbox1)
+namespace
+{
+/**
+ * @brief Footprint of a bounding box projected onto the xy plane.
+ *        It is a parallelogram (a rectangle if the pose has no roll or pitch)
+ *        centered at (x, y) and spanned by the half axes (ax, ay) and (bx, by).
+ *        z and height are kept for the height overlap check.
+ */
+struct Footprint2D
+{
+  double x;
+  double y;
+  double ax;
+  double ay;
+  double bx;
+  double by;
+  double z;
+  double height;
+};
+
+Footprint2D getFootprint2D(
+  const geometry_msgs::msg::Pose & pose, const traffic_simulator_msgs::msg::BoundingBox & bbox)
+{
+  /**
+   * @note Same transform as math::geometry::transformPoint, written out on plain doubles.
+   *       The footprint is taken at the top face of the bounding box,
+   *       consistent with math::geometry::getPointsFromBbox.
+   */
+  const auto & q = pose.orientation;
+  const double r00 = 1.0 - 2.0 * (q.y * q.y + q.z * q.z);
+  const double r01 = 2.0 * (q.x * q.y - q.z * q.w);
+  const double r02 = 2.0 * (q.x * q.z + q.y * q.w);
+  const double r10 = 2.0 * (q.x * q.y + q.z * q.w);
+  const double r11 = 1.0 - 2.0 * (q.x * q.x + q.z * q.z);
+  const double r12 = 2.0 * (q.y * q.z - q.x * q.w);
+  const double cx = bbox.center.x;
+  const double cy = bbox.center.y;
+  const double cz = bbox.center.z + bbox.dimensions.z * 0.5;
+  const double half_length = bbox.dimensions.x * 0.5;
+  const double half_width = bbox.dimensions.y * 0.5;
+  return Footprint2D{
+    pose.position.x + r00 * cx + r01 * cy + r02 * cz,
+    pose.position.y + r10 * cx + r11 * cy + r12 * cz,
+    r00 * half_length,
+    r10 * half_length,
+    r01 * half_width,
+    r11 * half_width,
+    pose.position.z + bbox.center.z,
+    bbox.dimensions.z};
+}
+
+/// Radius of the circle centered at the footprint center which encloses all of its corners.
+double getCircumscribedRadius(const Footprint2D & f)
 {
-  double z_diff_pose =
-    std::abs((pose0.position.z + bbox0.center.z) - (pose1.position.z + bbox1.center.z));
-  if (z_diff_pose > (std::abs(bbox0.dimensions.z + bbox1.dimensions.z) * 0.5)) {
+  return std::sqrt(
+    f.ax * f.ax + f.ay * f.ay + f.bx * f.bx + f.by * f.by +
+    2.0 * std::abs(f.ax * f.bx + f.ay * f.by));
+}
+
+/// Half length of the projection of the footprint onto the axis (nx, ny).
+double getProjectionRadius(const Footprint2D & f, double nx, double ny)
+{
+  return std::abs(f.ax * nx + f.ay * ny) + std::abs(f.bx * nx + f.by * ny);
+}
+
+/**
+ * @brief Check whether the axis (nx, ny) separates two footprints.
+ *        The axis does not need to be normalized, both sides of the inequality scale with it.
+ */
+bool isSeparatingAxis(
+  const Footprint2D & f0, const Footprint2D & f1, double dx, double dy, double nx, double ny)
+{
+  return std::abs(dx * nx + dy * ny) >
+         getProjectionRadius(f0, nx, ny) + getProjectionRadius(f1, nx, ny);
+}
+
+bool checkCollision2D(const Footprint2D & f0, const Footprint2D & f1)
+{
+  if (std::abs(f0.z - f1.z) > std::abs(f0.height + f1.height) * 0.5) {
     return false;
   }
-  namespace bg = boost::geometry;
-  typedef bg::model::d2::point_xy<double> bg_point;
-  const bg::model::polygon<bg_point> poly0 = math::geometry::get2DPolygon(pose0, bbox0);
-  const bg::model::polygon<bg_point> poly1 = math::geometry::get2DPolygon(pose1, bbox1);
-  if (bg::intersects(poly0, poly1)) {
-    return true;
-  }
-  if (bg::disjoint(poly0, poly1)) {
+  const double dx = f1.x - f0.x;
+  const double dy = f1.y - f0.y;
+  const double radius = getCircumscribedRadius(f0) + getCircumscribedRadius(f1);
+  if (dx * dx + dy * dy > radius * radius) {
     return false;
   }
-  return true;
+  /**
+   * @note The edges of each footprint are parallel to its half axes,
+   *       so the edge normals (-ay, ax) and (-by, bx) are the only candidate separating axes.
+   */
+  return !isSeparatingAxis(f0, f1, dx, dy, -f0.ay, f0.ax) &&
+         !isSeparatingAxis(f0, f1, dx, dy, -f0.by, f0.bx) &&
+         !isSeparatingAxis(f0, f1, dx, dy, -f1.ay, f1.ax) &&
+         !isSeparatingAxis(f0, f1, dx, dy, -f1.by, f1.bx);
+}
+}  // namespace
+
+bool checkCollision2D(
+  const geometry_msgs::msg::Pose & pose0, const traffic_simulator_msgs::msg::BoundingBox & bbox0,
+  const geometry_msgs::msg::Pose & pose1, const traffic_simulator_msgs::msg::BoundingBox & bbox1)
+{
+  return checkCollision2D(getFootprint2D(pose0, bbox0), getFootprint2D(pose1, bbox1));
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> getCollidingPairs2D(
+  const std::vector<geometry_msgs::msg::Pose> & poses,
+  const std::vector<traffic_simulator_msgs::msg::BoundingBox> & bboxes)
+{
+  if (poses.size() != bboxes.size()) {
+    THROW_SIMULATION_ERROR(
+      "Number of poses (", poses.size(), ") and bounding boxes (", bboxes.size(),
+      ") does not match.");
+  }
+  std::vector<Footprint2D> footprints;
+  footprints.reserve(poses.size());
+  for (std::size_t i = 0; i < poses.size(); ++i) {
+    footprints.push_back(getFootprint2D(poses[i], bboxes[i]));
+  }
+  const auto half_extent_x = [&](std::size_t i) {
+    return std::abs(footprints[i].ax) + std::abs(footprints[i].bx);
+  };
+  const auto half_extent_y = [&](std::size_t i) {
+    return std::abs(footprints[i].ay) + std::abs(footprints[i].by);
+  };
+  /**
+   * @note Sweep and prune along the x axis over the axis aligned bounding boxes of the footprints.
+   *       Only pairs whose axis aligned bounding boxes overlap are passed to the narrow phase.
+   */
+  std::vector<std::size_t> order(footprints.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::vector<double> min_x(footprints.size());
+  for (std::size_t i = 0; i < footprints.size(); ++i) {
+    min_x[i] = footprints[i].x - half_extent_x(i);
+  }
+  std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+    return min_x[a] < min_x[b];
+  });
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  std::vector<std::size_t> active;
+  for (const auto i : order) {
+    active.erase(
+      std::remove_if(
+        active.begin(), active.end(),
+        [&](std::size_t j) { return footprints[j].x + half_extent_x(j) < min_x[i]; }),
+      active.end());
+    for (const auto j : active) {
+      if (
+        std::abs(footprints[i].y - footprints[j].y) <= half_extent_y(i) + half_extent_y(j) and
+        checkCollision2D(footprints[i], footprints[j])) {
+        pairs.emplace_back(std::min(i, j), std::max(i, j));
+      }
+    }
+    active.push_back(i);
+  }
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
 }
 
 bool contains(
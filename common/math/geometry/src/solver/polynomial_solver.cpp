@@ -44,6 +44,86 @@ auto PolynomialSolver::cubic(
   return a * t * t * t + b * t * t + c * t + d;
 }
 
+auto PolynomialSolver::polynomial(const std::vector<double> & coefficients, const double t) const
+  -> double
+{
+  /// @note Horner's method
+  double ret = 0;
+  for (auto it = coefficients.rbegin(); it != coefficients.rend(); ++it) {
+    ret = ret * t + *it;
+  }
+  return ret;
+}
+
+auto PolynomialSolver::solvePolynomialEquation(
+  const std::vector<double> & coefficients, const double min_value, const double max_value) const
+  -> std::vector<double>
+{
+  /// @note Drop exactly zero coefficients of the highest degrees, so that the derivative of a non constant polynomial is never zero.
+  const auto trim = [](std::vector<double> c) {
+    while (not c.empty() and c.back() == 0) {
+      c.pop_back();
+    }
+    return c;
+  };
+
+  const auto solve_recursively = [this, trim, min_value, max_value](
+                                   const auto & self, const std::vector<double> & c) {
+    if (c.size() <= 1) {
+      /// @note Non zero constant polynomial, there is no solution.
+      return std::vector<double>();
+    }
+    std::vector<double> derivative;
+    for (size_t i = 1; i < c.size(); ++i) {
+      derivative.push_back(c[i] * i);
+    }
+    /// @note The polynomial is monotonic between consecutive stationary points.
+    std::vector<double> boundaries = {min_value};
+    for (const auto stationary_point : self(self, trim(derivative))) {
+      boundaries.push_back(stationary_point);
+    }
+    boundaries.push_back(max_value);
+
+    std::vector<double> solutions;
+    for (size_t i = 0; i + 1 < boundaries.size(); ++i) {
+      double lower = boundaries[i];
+      double upper = boundaries[i + 1];
+      double lower_value = polynomial(c, lower);
+      const double upper_value = polynomial(c, upper);
+      if (lower_value == 0) {
+        solutions.push_back(lower);
+      } else if (lower_value * upper_value < 0) {
+        /// @note 100 iterations of bisection are more than enough to reach double precision.
+        for (size_t iteration = 0; iteration < 100 and upper - lower > tolerance * tolerance;
+             ++iteration) {
+          const double middle = (lower + upper) * 0.5;
+          if (const double middle_value = polynomial(c, middle);
+              lower_value * middle_value <= 0) {
+            upper = middle;
+          } else {
+            lower = middle;
+            lower_value = middle_value;
+          }
+        }
+        solutions.push_back((lower + upper) * 0.5);
+      }
+    }
+    if (polynomial(c, max_value) == 0) {
+      solutions.push_back(max_value);
+    }
+    solutions.erase(std::unique(solutions.begin(), solutions.end()), solutions.end());
+    return solutions;
+  };
+
+  if (const auto trimmed = trim(coefficients); trimmed.empty()) {
+    THROW_SIMULATION_ERROR(
+      "Not computable x because all coefficients of the polynomial equation are zero, ",
+      "so any value of x will be the solution.");
+  } else {
+    return solve_recursively(solve_recursively, trimmed);
+  }
+}
+
 auto PolynomialSolver::solveLinearEquation(
   const double a, const double b, const double min_value, const double max_value) const
   -> std::vector<double>
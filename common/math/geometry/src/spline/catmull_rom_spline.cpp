@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <geometry/linear_algebra.hpp>
 #include <geometry/spline/catmull_rom_spline.hpp>
 #include <iostream>
@@ -227,7 +228,6 @@ CatmullRomSpline::CatmullRomSpline(const std::vector<geometry_msgs::msg::Point>
   }
   for (const auto & curve : curves_) {
     length_list_.emplace_back(curve.getLength());
-    maximum_2d_curvatures_.emplace_back(curve.getMaximum2DCurvature());
   }
   total_length_ = 0;
   for (const auto & length : length_list_) {
@@ -295,6 +295,70 @@ std::optional<double> CatmullRomSpline::getCollisionPointIn2D(
   return std::nullopt;
 }
 
+std::optional<double> CatmullRomSpline::getCollisionPointIn2D(
+  const std::vector<geometry_msgs::msg::Point> & polygon, double start_s, double end_s,
+  bool search_backward, bool close_start_end) const
+{
+  if (curves_.empty() || end_s < start_s) {
+    return std::nullopt;
+  }
+  /**
+   * @note As if the first (or last, if search_backward) collision point on the whole spline had to
+   * be in [start_s, end_s], a window starting (or ending) inside the polygon has no collision
+   * point.
+   */
+  if (close_start_end) {
+    const auto point = getPoint(search_backward ? end_s : start_s);
+    bool is_inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+      if (
+        (polygon[i].y > point.y) != (polygon[j].y > point.y) &&
+        point.x < polygon[i].x + (polygon[j].x - polygon[i].x) * (point.y - polygon[i].y) /
+                                   (polygon[j].y - polygon[i].y)) {
+        is_inside = !is_inside;
+      }
+    }
+    if (is_inside) {
+      return std::nullopt;
+    }
+  }
+  /// @note Each curve is only searched in the part of [start_s, end_s] which it overlaps.
+  const auto get_collision_point = [&](size_t i, double curve_start_s) -> std::optional<double> {
+    const double min_s = std::max(start_s - curve_start_s, 0.0);
+    const double max_s = std::min(end_s - curve_start_s, 1.0);
+    if (max_s < min_s) {
+      return std::nullopt;
+    }
+    if (const auto s = curves_[i].getCollisionPointIn2D(
+          polygon, search_backward, close_start_end, min_s, max_s)) {
+      return curve_start_s + s.value();
+    }
+    return std::nullopt;
+  };
+  const size_t first = getCurveIndexAndS(start_s).first;
+  const size_t last = getCurveIndexAndS(end_s).first;
+  if (search_backward) {
+    double curve_start_s = getSInSplineCurve(last, 0);
+    for (size_t i = last + 1; i-- > first;) {
+      if (const auto s = get_collision_point(i, curve_start_s)) {
+        return s;
+      }
+      if (i > 0) {
+        curve_start_s = curve_start_s - curves_[i - 1].getLength();
+      }
+    }
+  } else {
+    double curve_start_s = getSInSplineCurve(first, 0);
+    for (size_t i = first; i <= last; i++) {
+      if (const auto s = get_collision_point(i, curve_start_s)) {
+        return s;
+      }
+      curve_start_s = curve_start_s + curves_[i].getLength();
+    }
+  }
+  return std::nullopt;
+}
+
 std::optional<double> CatmullRomSpline::getCollisionPointIn2D(
   const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
   bool search_backward) const
@@ -369,10 +433,18 @@ const geometry_msgs::msg::Point CatmullRomSpline::getPoint(double s, double offs
 
 double CatmullRomSpline::getMaximum2DCurvature() const
 {
-  if (maximum_2d_curvatures_.empty()) {
+  if (curves_.empty()) {
     THROW_SIMULATION_ERROR("maximum 2D curvature vector size is 0.");  // LCOV_EXCL_LINE
   }
-  return *std::max_element(maximum_2d_curvatures_.begin(), maximum_2d_curvatures_.end());
+  if (not maximum_2d_curvature_) {
+    std::vector<double> maximum_2d_curvatures;
+    for (const auto & curve : curves_) {
+      maximum_2d_curvatures.emplace_back(curve.getMaximum2DCurvature());
+    }
+    maximum_2d_curvature_ =
+      *std::max_element(maximum_2d_curvatures.begin(), maximum_2d_curvatures.end());
+  }
+  return maximum_2d_curvature_.value();
 }
 
 const geometry_msgs::msg::Vector3 CatmullRomSpline::getNormalVector(double s) const
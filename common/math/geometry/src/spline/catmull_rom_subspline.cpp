@@ -26,17 +26,11 @@ std::optional<double> CatmullRomSubspline::getCollisionPointIn2D(
   const std::vector<geometry_msgs::msg::Point> & polygon, bool search_backward,
   bool close_start_end) const
 {
-  auto s = spline_->getCollisionPointIn2D(polygon, search_backward, close_start_end);
-
-  if (!s) {
-    return std::nullopt;
-  }
-
-  if (s.value() < start_s_ || end_s_ < s.value()) {
-    return std::nullopt;
+  if (const auto s = spline_.getCollisionPointIn2D(
+        polygon, start_s_, end_s_, search_backward, close_start_end)) {
+    return s.value() - start_s_;
   }
-
-  return s.value() - start_s_;
+  return std::nullopt;
 }
 }  // namespace geometry
 }  // namespace math
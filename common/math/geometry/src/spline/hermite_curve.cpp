@@ -90,7 +90,7 @@ geometry_msgs::msg::Vector3 HermiteCurve::getSquaredDistanceVector(
 
 std::optional<double> HermiteCurve::getCollisionPointIn2D(
   const std::vector<geometry_msgs::msg::Point> & polygon, bool search_backward,
-  bool close_start_end) const
+  bool close_start_end, double min_value, double max_value) const
 {
   size_t n = polygon.size();
   if (n <= 1) {
@@ -100,7 +100,7 @@ std::optional<double> HermiteCurve::getCollisionPointIn2D(
   for (size_t i = 0; i < (n - 1); i++) {
     const auto p0 = polygon[i];
     const auto p1 = polygon[i + 1];
-    auto s = getCollisionPointIn2D(p0, p1, search_backward);
+    auto s = getCollisionPointIn2D(p0, p1, search_backward, min_value, max_value);
     if (s) {
       s_values.push_back(s.value());
     }
@@ -108,7 +108,7 @@ std::optional<double> HermiteCurve::getCollisionPointIn2D(
   if (close_start_end) {
     const auto p0 = polygon[n - 1];
     const auto p1 = polygon[0];
-    auto s = getCollisionPointIn2D(p0, p1, search_backward);
+    auto s = getCollisionPointIn2D(p0, p1, search_backward, min_value, max_value);
     if (s) {
       s_values.push_back(s.value());
     }
@@ -124,7 +124,7 @@ std::optional<double> HermiteCurve::getCollisionPointIn2D(
 
 std::optional<double> HermiteCurve::getCollisionPointIn2D(
   const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
-  bool search_backward) const
+  bool search_backward, double min_value, double max_value) const
 {
   std::vector<double> s_values;
   double fx = point0.x;
@@ -136,21 +136,22 @@ std::optional<double> HermiteCurve::getCollisionPointIn2D(
   double c = cy_ * ex - cx_ * ey;
   double d = dy_ * ex - dx_ * ey - ex * fy + ey * fx;
 
-  const auto get_solutions = [search_backward, a, b, c, d, this]() -> std::vector<double> {
+  const auto get_solutions = [search_backward, min_value, max_value, a, b, c, d,
+                              this]() -> std::vector<double> {
     try {
       /**
-       * @note Obtain a solution to the cubic equation ax^3 + bx^2 + cx + d = 0 that falls within the range [0, 1].
+       * @note Obtain a solution to the cubic equation ax^3 + bx^2 + cx + d = 0 that falls within the range [min_value, max_value].
        */
-      return solver_.solveCubicEquation(a, b, c, d, 0, 1);
+      return solver_.solveCubicEquation(a, b, c, d, min_value, max_value);
     }
     /**
      * @note PolynomialSolver::solveCubicEquation throws common::SimulationError when any x value can satisfy the equation, 
      * so the beginning and end point of this curve can collide with the line segment.
-     * If search_backward = true, the line segment collisions at the end of the curve. So return 1.
-     * If search_backward = false, the line segment collisions at the start of the curve. So return 0.
+     * If search_backward = true, the line segment collisions at the end of the range. So return max_value.
+     * If search_backward = false, the line segment collisions at the start of the range. So return min_value.
      */
     catch (const common::SimulationError &) {
-      return {search_backward ? 1.0 : 0.0};
+      return {search_backward ? max_value : min_value};
     }
   };
 
@@ -289,17 +290,63 @@ double HermiteCurve::get2DCurvature(double s, bool autoscale) const
 
 std::pair<double, double> HermiteCurve::get2DMinMaxCurvatureValue() const
 {
-  std::pair<double, double> ret;
-  std::vector<double> curvatures;
   /**
-   * @brief 0.1 is a sampling resolution of the curvature
+   * @note The curvature is k(s) = N(s) / D(s)^1.5, where N(s) = x'(s)y''(s) - x''(s)y'(s) is quadratic
+   * (cubic terms cancel out) and D(s) = x'(s)^2 + y'(s)^2 is quartic.
+   * k'(s) = 0 is equivalent to N'(s)D(s) - 3N(s)(x'(s)x''(s) + y'(s)y''(s)) = 0, which is quintic.
+   * So the extrema of the curvature are at s = 0, s = 1 or the roots of this quintic polynomial.
+   * All polynomials below hold coefficients in ascending order of degree.
    */
-  for (double s = 0; s <= 1; s = s + 0.1) {
-    double curvature = get2DCurvature(s);
-    curvatures.push_back(curvature);
+  const auto multiply = [](const std::vector<double> & p, const std::vector<double> & q) {
+    std::vector<double> ret(p.size() + q.size() - 1, 0.0);
+    for (size_t i = 0; i < p.size(); ++i) {
+      for (size_t j = 0; j < q.size(); ++j) {
+        ret[i + j] += p[i] * q[j];
+      }
+    }
+    return ret;
+  };
+  /// @note Returns p + scale * q
+  const auto add = [](std::vector<double> p, const std::vector<double> & q, double scale) {
+    p.resize(std::max(p.size(), q.size()), 0.0);
+    for (size_t i = 0; i < q.size(); ++i) {
+      p[i] += scale * q[i];
+    }
+    return p;
+  };
+  const std::vector<double> x_dot = {cx_, 2 * bx_, 3 * ax_};
+  const std::vector<double> x_dot_dot = {2 * bx_, 6 * ax_};
+  const std::vector<double> y_dot = {cy_, 2 * by_, 3 * ay_};
+  const std::vector<double> y_dot_dot = {2 * by_, 6 * ay_};
+  const std::vector<double> numerator = {
+    2 * (cx_ * by_ - bx_ * cy_), 6 * (cx_ * ay_ - ax_ * cy_), 6 * (bx_ * ay_ - ax_ * by_)};
+  const std::vector<double> numerator_dot = {numerator[1], 2 * numerator[2]};
+  const auto denominator = add(multiply(x_dot, x_dot), multiply(y_dot, y_dot), 1.0);
+  const auto half_denominator_dot =
+    add(multiply(x_dot, x_dot_dot), multiply(y_dot, y_dot_dot), 1.0);
+  const auto stationary_condition =
+    add(multiply(numerator_dot, denominator), multiply(numerator, half_denominator_dot), -3.0);
+
+  std::vector<double> candidates = {0.0, 1.0};
+  try {
+    for (const auto s : solver_.solvePolynomialEquation(stationary_condition, 0, 1)) {
+      candidates.push_back(s);
+    }
+  }
+  /**
+   * @note PolynomialSolver::solvePolynomialEquation throws common::SimulationError when any s value can satisfy the equation,
+   * which means the curvature is constant, so checking the beginning and end point of this curve is enough.
+   */
+  catch (const common::SimulationError &) {
+  }
+
+  std::pair<double, double> ret = {
+    std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+  for (const auto s : candidates) {
+    const double curvature = get2DCurvature(s);
+    ret.first = std::min(ret.first, curvature);
+    ret.second = std::max(ret.second, curvature);
   }
-  ret.first = *std::min_element(curvatures.begin(), curvatures.end());
-  ret.second = *std::max_element(curvatures.begin(), curvatures.end());
   return ret;
 }
 
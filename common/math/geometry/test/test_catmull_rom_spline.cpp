@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include <geometry/spline/catmull_rom_spline.hpp>
+#include <geometry/spline/catmull_rom_subspline.hpp>
 #include <scenario_simulator_exception/exception.hpp>
 
 #include "expect_eq_macros.hpp"
@@ -55,6 +56,59 @@ TEST(CatmullRomSpline, GetCollisionPointIn2D)
   }
 }
 
+TEST(CatmullRomSpline, GetCollisionPointIn2DInSubspline)
+{
+  std::vector<geometry_msgs::msg::Point> points(5);
+  for (size_t i = 0; i < points.size(); ++i) {
+    points[i].x = i;
+  }
+  auto spline = math::geometry::CatmullRomSpline(points);
+  std::vector<geometry_msgs::msg::Point> polygon(4);
+  polygon[0].x = 0.5;
+  polygon[0].y = 1.0;
+  polygon[1].x = 2.5;
+  polygon[1].y = 1.0;
+  polygon[2].x = 2.5;
+  polygon[2].y = -1.0;
+  polygon[3].x = 0.5;
+  polygon[3].y = -1.0;
+  auto collision_s = spline.getCollisionPointIn2D(polygon, false);
+  EXPECT_TRUE(collision_s);
+  if (collision_s) {
+    EXPECT_DOUBLE_EQ(collision_s.value(), 0.5);
+  }
+  /// @note The subspline starts (or ends, if searching backward) inside the polygon.
+  auto subspline = math::geometry::CatmullRomSubspline(spline, 1.0, 3.0);
+  EXPECT_DOUBLE_EQ(subspline.getLength(), 2.0);
+  EXPECT_FALSE(subspline.getCollisionPointIn2D(polygon, false));
+  EXPECT_FALSE(
+    math::geometry::CatmullRomSubspline(spline, 0.0, 2.0).getCollisionPointIn2D(polygon, true));
+  EXPECT_FALSE(
+    math::geometry::CatmullRomSubspline(spline, 3.0, 4.0).getCollisionPointIn2D(polygon, false));
+  /// @note The line string crosses the curve between 1 and 2 twice, on both sides of the subspline.
+  std::vector<geometry_msgs::msg::Point> line_string(4);
+  line_string[0].x = 1.2;
+  line_string[0].y = 1.0;
+  line_string[1].x = 1.2;
+  line_string[1].y = -1.0;
+  line_string[2].x = 1.6;
+  line_string[2].y = -1.0;
+  line_string[3].x = 1.6;
+  line_string[3].y = 1.0;
+  collision_s = math::geometry::CatmullRomSubspline(spline, 1.4, 4.0).getCollisionPointIn2D(
+    line_string, false, false);
+  EXPECT_TRUE(collision_s);
+  if (collision_s) {
+    EXPECT_NEAR(collision_s.value(), 0.2, 1e-6);
+  }
+  collision_s = math::geometry::CatmullRomSubspline(spline, 0.0, 1.4).getCollisionPointIn2D(
+    line_string, true, false);
+  EXPECT_TRUE(collision_s);
+  if (collision_s) {
+    EXPECT_NEAR(collision_s.value(), 1.2, 1e-6);
+  }
+}
+
 TEST(CatmullRomSpline, Maximum2DCurvature)
 {
   geometry_msgs::msg::Point p0;
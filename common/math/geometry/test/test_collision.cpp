@@ -13,10 +13,38 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <quaternion_operation/quaternion_operation.h>
 
+#include <boost/geometry.hpp>
+#include <geometry/bounding_box.hpp>
 #include <geometry/intersection/collision.hpp>
+#include <random>
 #include <scenario_simulator_exception/exception.hpp>
 
+geometry_msgs::msg::Quaternion makeQuaternion(double roll, double pitch, double yaw)
+{
+  geometry_msgs::msg::Vector3 rpy;
+  rpy.x = roll;
+  rpy.y = pitch;
+  rpy.z = yaw;
+  return quaternion_operation::convertEulerAngleToQuaternion(rpy);
+}
+
+/// Reference implementation of checkCollision2D using boost::geometry polygons.
+bool checkCollision2DWithBoost(
+  const geometry_msgs::msg::Pose & pose0, const traffic_simulator_msgs::msg::BoundingBox & bbox0,
+  const geometry_msgs::msg::Pose & pose1, const traffic_simulator_msgs::msg::BoundingBox & bbox1)
+{
+  double z_diff_pose =
+    std::abs((pose0.position.z + bbox0.center.z) - (pose1.position.z + bbox1.center.z));
+  if (z_diff_pose > (std::abs(bbox0.dimensions.z + bbox1.dimensions.z) * 0.5)) {
+    return false;
+  }
+  const auto poly0 = math::geometry::get2DPolygon(pose0, bbox0);
+  const auto poly1 = math::geometry::get2DPolygon(pose1, bbox1);
+  return boost::geometry::intersects(poly0, poly1) || !boost::geometry::disjoint(poly0, poly1);
+}
+
 TEST(Collision, DifferentHeight)
 {
   geometry_msgs::msg::Pose pose0;
@@ -52,6 +80,111 @@ TEST(Collision, SameHeightNoCollision)
   EXPECT_FALSE(math::geometry::checkCollision2D(pose0, box, pose1, box));
 }
 
+TEST(Collision, RotatedNoCollision)
+{
+  geometry_msgs::msg::Pose pose0;
+  geometry_msgs::msg::Pose pose1;
+  traffic_simulator_msgs::msg::BoundingBox box;
+  box.dimensions.x = 4.0;
+  box.dimensions.y = 1.0;
+  box.dimensions.z = 1.0;
+  pose0.orientation = makeQuaternion(0.0, 0.0, M_PI * 0.25);
+  pose1.position.x = 2.0;
+  pose1.position.y = -1.0;
+  pose1.orientation = makeQuaternion(0.0, 0.0, M_PI * 0.25);
+  EXPECT_FALSE(math::geometry::checkCollision2D(pose0, box, pose1, box));
+}
+
+TEST(Collision, RotatedCollision)
+{
+  geometry_msgs::msg::Pose pose0;
+  geometry_msgs::msg::Pose pose1;
+  traffic_simulator_msgs::msg::BoundingBox box;
+  box.dimensions.x = 4.0;
+  box.dimensions.y = 1.0;
+  box.dimensions.z = 1.0;
+  pose0.orientation = makeQuaternion(0.0, 0.0, M_PI * 0.25);
+  pose1.position.x = 2.0;
+  pose1.position.y = -1.0;
+  pose1.orientation = makeQuaternion(0.0, 0.0, -M_PI * 0.25);
+  EXPECT_TRUE(math::geometry::checkCollision2D(pose0, box, pose1, box));
+}
+
+TEST(Collision, Touching)
+{
+  geometry_msgs::msg::Pose pose0;
+  geometry_msgs::msg::Pose pose1;
+  traffic_simulator_msgs::msg::BoundingBox box;
+  box.dimensions.x = 1.0;
+  box.dimensions.y = 1.0;
+  box.dimensions.z = 1.0;
+  pose1.position.x = 1.0;
+  EXPECT_TRUE(math::geometry::checkCollision2D(pose0, box, pose1, box));
+}
+
+TEST(Collision, CompareWithBoostGeometry)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position(-6.0, 6.0);
+  std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+  std::uniform_real_distribution<double> tilt(-0.3, 0.3);
+  std::uniform_real_distribution<double> dimension(0.3, 5.0);
+  for (std::size_t i = 0; i < 10000; ++i) {
+    geometry_msgs::msg::Pose pose[2];
+    traffic_simulator_msgs::msg::BoundingBox box[2];
+    for (std::size_t j = 0; j < 2; ++j) {
+      pose[j].position.x = position(engine);
+      pose[j].position.y = position(engine);
+      pose[j].orientation = makeQuaternion(tilt(engine), tilt(engine), yaw(engine));
+      box[j].center.x = position(engine) * 0.1;
+      box[j].center.z = 1.0;
+      box[j].dimensions.x = dimension(engine);
+      box[j].dimensions.y = dimension(engine);
+      box[j].dimensions.z = dimension(engine);
+    }
+    EXPECT_EQ(
+      math::geometry::checkCollision2D(pose[0], box[0], pose[1], box[1]),
+      checkCollision2DWithBoost(pose[0], box[0], pose[1], box[1]));
+  }
+}
+
+TEST(Collision, CollidingPairsMatchPairwiseCheck)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+  std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+  std::uniform_real_distribution<double> dimension(0.3, 5.0);
+  std::vector<geometry_msgs::msg::Pose> poses(500);
+  std::vector<traffic_simulator_msgs::msg::BoundingBox> boxes(500);
+  for (std::size_t i = 0; i < poses.size(); ++i) {
+    poses[i].position.x = position(engine);
+    poses[i].position.y = position(engine);
+    poses[i].orientation = makeQuaternion(0.0, 0.0, yaw(engine));
+    boxes[i].dimensions.x = dimension(engine);
+    boxes[i].dimensions.y = dimension(engine);
+    boxes[i].dimensions.z = dimension(engine);
+  }
+  std::vector<std::pair<std::size_t, std::size_t>> expected;
+  for (std::size_t i = 0; i < poses.size(); ++i) {
+    for (std::size_t j = i + 1; j < poses.size(); ++j) {
+      if (math::geometry::checkCollision2D(poses[i], boxes[i], poses[j], boxes[j])) {
+        expected.emplace_back(i, j);
+      }
+    }
+  }
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(math::geometry::getCollidingPairs2D(poses, boxes), expected);
+}
+
+TEST(Collision, CollidingPairsSizeMismatch)
+{
+  EXPECT_THROW(
+    math::geometry::getCollidingPairs2D(
+      std::vector<geometry_msgs::msg::Pose>(2),
+      std::vector<traffic_simulator_msgs::msg::BoundingBox>(1)),
+    common::SimulationError);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -162,6 +162,30 @@ TEST(HermiteCurveTest, CheckNormalVector)
   }
 }
 
+/// @note The analytic maximum curvature must match the one found by sampling the curve densely.
+TEST(HermiteCurveTest, CheckMaximum2DCurvature)
+{
+  geometry_msgs::msg::Pose start_pose, goal_pose;
+  geometry_msgs::msg::Vector3 start_vec, goal_vec;
+  start_pose.position.x = 0;
+  start_pose.position.y = 0;
+  goal_pose.position.x = 10;
+  goal_pose.position.y = 5;
+  start_vec.x = 10;
+  start_vec.y = 0;
+  goal_vec.x = 0;
+  goal_vec.y = 10;
+  math::geometry::HermiteCurve curve(start_pose, goal_pose, start_vec, goal_vec);
+  double sampled_max = 0;
+  for (int i = 0; i <= 10000; ++i) {
+    const double curvature = curve.get2DCurvature(i / 10000.0, false);
+    if (std::fabs(curvature) > std::fabs(sampled_max)) {
+      sampled_max = curvature;
+    }
+  }
+  EXPECT_NEAR(curve.getMaximum2DCurvature(), sampled_max, 1e-6);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
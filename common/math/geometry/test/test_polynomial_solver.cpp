@@ -201,6 +201,22 @@ TEST(PolynomialSolverTest, SolveCubicEquation)
   }
 }
 
+/// @note Testcase for (x-0.2)(x-0.5)(x-0.9)(x+1)(x-2) = 0, only the roots in [0, 1] are expected.
+TEST(PolynomialSolverTest, SolvePolynomialEquation)
+{
+  math::geometry::PolynomialSolver solver;
+  const std::vector<double> coefficients = {0.18, -1.37, 2.38, 0.33, -2.6, 1.0};
+  const auto ret = solver.solvePolynomialEquation(coefficients, 0, 1);
+  ASSERT_EQ(ret.size(), static_cast<std::size_t>(3));
+  EXPECT_TRUE(checkValueWithTolerance(ret[0], 0.2));
+  EXPECT_TRUE(checkValueWithTolerance(ret[1], 0.5));
+  EXPECT_TRUE(checkValueWithTolerance(ret[2], 0.9));
+  for (const auto & solution : ret) {
+    EXPECT_TRUE(checkValueWithTolerance(solver.polynomial(coefficients, solution), 0.0));
+  }
+  EXPECT_THROW(solver.solvePolynomialEquation({0, 0, 0}, 0, 1), common::SimulationError);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
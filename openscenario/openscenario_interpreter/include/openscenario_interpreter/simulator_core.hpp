@@ -346,9 +346,15 @@ public:
     }
 
     template <typename... Ts>
-    static auto evaluateCollisionCondition(Ts &&... xs) -> bool
+    static auto evaluateCollidingPairs(Ts &&... xs) -> decltype(auto)
     {
-      return core->checkCollision(std::forward<decltype(xs)>(xs)...);
+      return core->getCollidingPairs(std::forward<decltype(xs)>(xs)...);
+    }
+
+    template <typename... Ts>
+    static auto evaluateCollision(Ts &&... xs) -> bool
+    {
+      return core->isColliding(std::forward<decltype(xs)>(xs)...);
     }
 
     template <typename... Ts>
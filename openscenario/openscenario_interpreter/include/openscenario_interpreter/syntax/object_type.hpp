@@ -15,6 +15,8 @@
 #ifndef OPENSCENARIO_INTERPRETER__SYNTAX__OBJECT_TYPE_HPP_
 #define OPENSCENARIO_INTERPRETER__SYNTAX__OBJECT_TYPE_HPP_
 
+#include <iostream>
+
 namespace openscenario_interpreter
 {
 inline namespace syntax
@@ -39,7 +41,21 @@ inline namespace syntax
  * -------------------------------------------------------------------------- */
 struct ObjectType
 {
+  enum value_type {
+    // NOTE: Sorted by lexicographic order.
+    miscellaneous,
+    pedestrian,
+    vehicle,
+  } value;
+
+  explicit constexpr ObjectType(value_type value = vehicle) : value(value) {}
+
+  constexpr operator value_type() const noexcept { return value; }
 };
+
+auto operator>>(std::istream &, ObjectType &) -> std::istream &;
+
+auto operator<<(std::ostream &, const ObjectType &) -> std::ostream &;
 }  // namespace syntax
 }  // namespace openscenario_interpreter
 
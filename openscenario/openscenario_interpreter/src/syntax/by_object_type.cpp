@@ -0,0 +1,49 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <openscenario_interpreter/reader/attribute.hpp>
+#include <openscenario_interpreter/syntax/by_object_type.hpp>
+#include <openscenario_interpreter/syntax/entities.hpp>
+#include <openscenario_interpreter/syntax/scenario_object.hpp>
+
+namespace openscenario_interpreter
+{
+inline namespace syntax
+{
+ByObjectType::ByObjectType(const pugi::xml_node & node, Scope & scope)
+: Scope(scope), type(readAttribute<ObjectType>("type", node, scope))
+{
+}
+
+auto ByObjectType::includes(const EntityRef & entity_ref) const -> bool
+{
+  if (const auto iter = global().entities->find(entity_ref);
+      iter != global().entities->end()) {
+    const auto & entity_object = iter->second.as<ScenarioObject>();
+    switch (type) {
+      case ObjectType::miscellaneous:
+        return entity_object.is<MiscObject>();
+      case ObjectType::pedestrian:
+        return entity_object.is<Pedestrian>();
+      case ObjectType::vehicle:
+        return entity_object.is<Vehicle>();
+      default:
+        return false;
+    }
+  } else {
+    return false;  // NOTE: Not an entity of this scenario.
+  }
+}
+}  // namespace syntax
+}  // namespace openscenario_interpreter
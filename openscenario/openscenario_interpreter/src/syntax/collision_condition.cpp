@@ -12,11 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <openscenario_interpreter/reader/element.hpp>
 #include <openscenario_interpreter/simulator_core.hpp>
+#include <openscenario_interpreter/syntax/by_object_type.hpp>
 #include <openscenario_interpreter/syntax/collision_condition.hpp>
 #include <openscenario_interpreter/syntax/entities.hpp>
 #include <openscenario_interpreter/syntax/entity_ref.hpp>
+#include <string>
+#include <utility>
 
 namespace openscenario_interpreter
 {
@@ -28,8 +32,8 @@ CollisionCondition::CollisionCondition(
 : Scope(scope),
   another_given_entity(
     choice(node,
-      std::make_pair("EntityRef", [&](auto && node) { return make<EntityRef>(node, scope); }),
-      std::make_pair("ByType",    [&](auto && node) { throw UNSUPPORTED_ELEMENT_SPECIFIED(node.name()); return unspecified; }))),
+      std::make_pair("EntityRef", [&](auto && node) { return make<EntityRef   >(node, scope); }),
+      std::make_pair("ByType",    [&](auto && node) { return make<ByObjectType>(node, scope); }))),
   triggering_entities(triggering_entities)
 // clang-format on
 {
@@ -39,25 +43,49 @@ auto CollisionCondition::description() const -> std::string
 {
   std::stringstream description;
 
-  description << triggering_entities.description() << " colliding with another given entity "
-              << another_given_entity << "?";
-
-  // TODO (yamacir-kit): If another_given_entity.is<ByType>(), description
-  // will be "Is any of [A, B, C] colliding with another T typed entities?"
+  if (another_given_entity.is<ByObjectType>()) {
+    description << triggering_entities.description() << " colliding with any entity of type "
+                << another_given_entity.as<ByObjectType>().type << "?";
+  } else {
+    description << triggering_entities.description() << " colliding with another given entity "
+                << another_given_entity << "?";
+  }
 
   return description.str();
 }
 
+/**
+ * @note Both branches read the colliding pairs of the current frame, which the simulator computes
+ * once with a broad phase over all entities, instead of testing each pair of entities here.
+ */
 auto CollisionCondition::evaluate() const -> Object
 {
   if (
     another_given_entity.is<EntityRef>() and
     global().entities->isAdded(another_given_entity.as<EntityRef>())) {
+    const auto & colliding_pairs = evaluateCollidingPairs();
+    return asBoolean(triggering_entities.apply([&](auto && triggering_entity) {
+      const std::string & another_entity = another_given_entity.as<EntityRef>();
+      return triggering_entity != another_entity and
+             std::binary_search(
+               colliding_pairs.begin(), colliding_pairs.end(),
+               std::pair<std::string, std::string>(
+                 std::minmax<std::string>(triggering_entity, another_entity)));
+    }));
+  } else if (another_given_entity.is<ByObjectType>()) {
+    const auto & colliding_pairs = evaluateCollidingPairs();
     return asBoolean(triggering_entities.apply([&](auto && triggering_entity) {
-      return evaluateCollisionCondition(triggering_entity, another_given_entity.as<EntityRef>());
+      return global().entities->isAdded(triggering_entity) and
+             evaluateCollision(triggering_entity) and
+             std::any_of(colliding_pairs.begin(), colliding_pairs.end(), [&](auto && pair) {
+               const auto & [name0, name1] = pair;
+               return (name0 == triggering_entity and
+                       another_given_entity.as<ByObjectType>().includes(name1)) or
+                      (name1 == triggering_entity and
+                       another_given_entity.as<ByObjectType>().includes(name0));
+             });
     }));
   } else {
-    // TODO ByType
     return false_v;
   }
 }
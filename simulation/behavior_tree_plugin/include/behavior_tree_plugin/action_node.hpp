@@ -25,6 +25,7 @@
 #include <traffic_simulator/behavior/behavior_plugin_base.hpp>
 #include <traffic_simulator/data_type/behavior.hpp>
 #include <traffic_simulator/data_type/entity_status.hpp>
+#include <traffic_simulator/data_type/world_snapshot.hpp>
 #include <traffic_simulator/entity/entity_base.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator/helper/stop_watch.hpp>
@@ -138,6 +139,10 @@ private:
     -> std::vector<traffic_simulator::CanonicalizedEntityStatus>;
   auto getConflictingEntityStatusOnLane(const std::vector<std::int64_t> & route_lanelets) const
     -> std::vector<traffic_simulator::CanonicalizedEntityStatus>;
+  auto getEntityStatusOnLanelets(const std::vector<std::int64_t> & lanelet_ids) const
+    -> std::vector<traffic_simulator::CanonicalizedEntityStatus>;
+  auto getEntityStatusInIdOrder(std::vector<traffic_simulator::EntityId> ids) const
+    -> std::vector<traffic_simulator::CanonicalizedEntityStatus>;
 };
 }  // namespace entity_behavior
 
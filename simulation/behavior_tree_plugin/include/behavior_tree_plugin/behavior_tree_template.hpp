@@ -0,0 +1,58 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BEHAVIOR_TREE_PLUGIN__BEHAVIOR_TREE_TEMPLATE_HPP_
+#define BEHAVIOR_TREE_PLUGIN__BEHAVIOR_TREE_TEMPLATE_HPP_
+
+#include <behaviortree_cpp_v3/bt_factory.h>
+#include <behaviortree_cpp_v3/xml_parsing.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace behavior_tree_plugin
+{
+/**
+ * @brief Factory and parsed XML of a behavior tree, shared by all entities using the tree.
+ * @note Registering node types, loading the XML file, adding the ports to it and parsing it are
+ * done once in the constructor, so instantiating a tree for each spawned entity only creates nodes.
+ * Each tree gets its own blackboard, so trees instantiated from one template share no state.
+ */
+class BehaviorTreeTemplate
+{
+public:
+  explicit BehaviorTreeTemplate(
+    const std::string & format_path,
+    const std::function<void(BT::BehaviorTreeFactory &)> & register_node_types);
+
+  BehaviorTreeTemplate(const BehaviorTreeTemplate &) = delete;
+
+  BehaviorTreeTemplate & operator=(const BehaviorTreeTemplate &) = delete;
+
+  auto instantiate() const -> BT::Tree;
+
+private:
+  BT::BehaviorTreeFactory factory_;
+
+  /// @note Refers to factory_, so it has to be declared after factory_.
+  std::unique_ptr<BT::XMLParser> parser_;
+
+  /// @note BT::XMLParser::instantiateTree is not const.
+  mutable std::mutex mutex_;
+};
+}  // namespace behavior_tree_plugin
+
+#endif  // BEHAVIOR_TREE_PLUGIN__BEHAVIOR_TREE_TEMPLATE_HPP_
@@ -65,7 +65,8 @@ protected:
   traffic_simulator_msgs::msg::BehaviorParameter behavior_parameter;
   traffic_simulator_msgs::msg::VehicleParameters vehicle_parameters;
   std::shared_ptr<math::geometry::CatmullRomSpline> reference_trajectory;
-  std::unique_ptr<math::geometry::CatmullRomSubspline> trajectory;
+  /// @note View of reference_trajectory, reset whenever reference_trajectory is replaced.
+  std::optional<math::geometry::CatmullRomSubspline> trajectory;
 };
 }  // namespace entity_behavior
 
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <behavior_tree_plugin/action_node.hpp>
 #include <geometry/bounding_box.hpp>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <rclcpp/rclcpp.hpp>
@@ -93,12 +94,8 @@ auto ActionNode::getOtherEntityStatus(std::int64_t lanelet_id) const
   -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
   std::vector<traffic_simulator::CanonicalizedEntityStatus> ret;
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() &&
-      traffic_simulator::isSameLaneletId(status.second, lanelet_id)) {
-      ret.emplace_back(status.second);
-    }
+  for (const auto id : other_entity_status.getIdsOnLanelet(lanelet_id)) {
+    ret.emplace_back(other_entity_status.getStatus(id));
   }
   return ret;
 }
@@ -130,20 +127,15 @@ auto ActionNode::getYieldStopDistance(const std::vector<std::int64_t> & followin
 auto ActionNode::getRightOfWayEntities(const std::vector<std::int64_t> & following_lanelets) const
   -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
-  std::vector<traffic_simulator::CanonicalizedEntityStatus> ret;
+  std::vector<traffic_simulator::EntityId> ids;
   const auto lanelet_ids_list = hdmap_utils->getRightOfWayLaneletIds(following_lanelets);
-  for (const auto & status : other_entity_status) {
-    for (const auto & following_lanelet : following_lanelets) {
-      for (const std::int64_t & lanelet_id : lanelet_ids_list.at(following_lanelet)) {
-        if (
-          status.second.laneMatchingSucceed() &&
-          traffic_simulator::isSameLaneletId(status.second, lanelet_id)) {
-          ret.emplace_back(status.second);
-        }
-      }
+  for (const auto & following_lanelet : following_lanelets) {
+    for (const std::int64_t & lanelet_id : lanelet_ids_list.at(following_lanelet)) {
+      const auto ids_on_lanelet = other_entity_status.getIdsOnLanelet(lanelet_id);
+      ids.insert(ids.end(), ids_on_lanelet.begin(), ids_on_lanelet.end());
     }
   }
-  return ret;
+  return getEntityStatusInIdOrder(ids);
 }
 
 auto ActionNode::getRightOfWayEntities() const
@@ -152,20 +144,23 @@ auto ActionNode::getRightOfWayEntities() const
   if (!entity_status->laneMatchingSucceed()) {
     return {};
   }
+  std::vector<traffic_simulator::EntityId> ids;
+  for (const std::int64_t & lanelet_id :
+       hdmap_utils->getRightOfWayLaneletIds(entity_status->getLaneletPose().lanelet_id)) {
+    const auto ids_on_lanelet = other_entity_status.getIdsOnLanelet(lanelet_id);
+    ids.insert(ids.end(), ids_on_lanelet.begin(), ids_on_lanelet.end());
+  }
+  return getEntityStatusInIdOrder(ids);
+}
+
+auto ActionNode::getEntityStatusInIdOrder(std::vector<traffic_simulator::EntityId> ids) const
+  -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
+{
+  /// @note Stable, so that the result is the same as iterating over all the entities.
+  std::stable_sort(ids.begin(), ids.end());
   std::vector<traffic_simulator::CanonicalizedEntityStatus> ret;
-  const auto lanelet_ids =
-    hdmap_utils->getRightOfWayLaneletIds(entity_status->getLaneletPose().lanelet_id);
-  if (lanelet_ids.empty()) {
-    return ret;
-  }
-  for (const auto & status : other_entity_status) {
-    for (const std::int64_t & lanelet_id : lanelet_ids) {
-      if (
-        status.second.laneMatchingSucceed() &&
-        traffic_simulator::isSameLaneletId(status.second, lanelet_id)) {
-        ret.emplace_back(status.second);
-      }
-    }
+  for (const auto id : ids) {
+    ret.emplace_back(other_entity_status.getStatus(id));
   }
   return ret;
 }
@@ -218,21 +213,36 @@ auto ActionNode::getDistanceToFrontEntity(
 auto ActionNode::getFrontEntityName(const math::geometry::CatmullRomSplineInterface & spline) const
   -> std::optional<std::string>
 {
+  /**
+   * @note hard-coded parameter, entities farther than 40 m along the spline are not front entity.
+   */
+  constexpr double max_distance = 40;
   std::vector<double> distances;
   std::vector<std::string> entities;
-  for (const auto & each : other_entity_status) {
-    const auto distance = getDistanceToTargetEntityPolygon(spline, each.first);
+  /**
+   * @note The spline starts on the lane center next to this entity and the distance along the
+   * spline is never shorter than the straight one, so only the entities within max_distance plus
+   * the lateral offset from this entity can be in front of it.
+   */
+  const auto search_distance =
+    entity_status->laneMatchingSucceed()
+      ? max_distance + std::fabs(entity_status->getLaneletPose().offset) + 1.0
+      : std::numeric_limits<double>::infinity();
+  for (const auto id :
+       other_entity_status.getIdsWithin(entity_status->getMapPose().position, search_distance)) {
+    const auto & name = other_entity_status.getName(id);
+    const auto distance = getDistanceToTargetEntityPolygon(spline, name);
     const auto quat = quaternion_operation::getRotation(
       entity_status->getMapPose().orientation,
-      other_entity_status.at(each.first).getMapPose().orientation);
+      other_entity_status.getStatus(id).getMapPose().orientation);
     /**
      * @note hard-coded parameter, if the Yaw value of RPY is in ~1.5708 -> 1.5708, entity is a candidate of front entity.
      */
     if (
       std::fabs(quaternion_operation::convertQuaternionToEulerAngle(quat).z) <=
       boost::math::constants::half_pi<double>()) {
-      if (distance && distance.value() < 40) {
-        entities.emplace_back(each.first);
+      if (distance && distance.value() < max_distance) {
+        entities.emplace_back(name);
         distances.emplace_back(distance.value());
       }
     }
@@ -327,57 +337,39 @@ auto ActionNode::getConflictingEntityStatusOnCrossWalk(
   const std::vector<std::int64_t> & route_lanelets) const
   -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
-  std::vector<traffic_simulator::CanonicalizedEntityStatus> conflicting_entity_status;
-  auto conflicting_crosswalks = hdmap_utils->getConflictingCrosswalkIds(route_lanelets);
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() &&
-      std::count(
-        conflicting_crosswalks.begin(), conflicting_crosswalks.end(),
-        status.second.getLaneletPose().lanelet_id) >= 1) {
-      conflicting_entity_status.emplace_back(status.second);
-    }
-  }
-  return conflicting_entity_status;
+  return getEntityStatusOnLanelets(hdmap_utils->getConflictingCrosswalkIds(route_lanelets));
 }
 
 auto ActionNode::getConflictingEntityStatusOnLane(const std::vector<std::int64_t> & route_lanelets)
   const -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
-  std::vector<traffic_simulator::CanonicalizedEntityStatus> conflicting_entity_status;
-  auto conflicting_lanes = hdmap_utils->getConflictingLaneIds(route_lanelets);
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() && std::count(
-                                               conflicting_lanes.begin(), conflicting_lanes.end(),
-                                               status.second.getLaneletPose().lanelet_id) >= 1) {
-      conflicting_entity_status.emplace_back(status.second);
-    }
-  }
-  return conflicting_entity_status;
+  return getEntityStatusOnLanelets(hdmap_utils->getConflictingLaneIds(route_lanelets));
+}
+
+auto ActionNode::getEntityStatusOnLanelets(const std::vector<std::int64_t> & lanelet_ids) const
+  -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
+{
+  std::vector<traffic_simulator::EntityId> ids;
+  for (const auto & lanelet_id : lanelet_ids) {
+    const auto ids_on_lanelet = other_entity_status.getIdsOnLanelet(lanelet_id);
+    ids.insert(ids.end(), ids_on_lanelet.begin(), ids_on_lanelet.end());
+  }
+  /// @note Each entity is returned once even if lanelet_ids contains duplicates.
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return getEntityStatusInIdOrder(ids);
 }
 
 auto ActionNode::foundConflictingEntity(const std::vector<std::int64_t> & following_lanelets) const
   -> bool
 {
-  auto conflicting_crosswalks = hdmap_utils->getConflictingCrosswalkIds(following_lanelets);
-  auto conflicting_lanes = hdmap_utils->getConflictingLaneIds(following_lanelets);
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() &&
-      std::count(
-        conflicting_crosswalks.begin(), conflicting_crosswalks.end(),
-        status.second.getLaneletPose().lanelet_id) >= 1) {
-      return true;
-    }
-    if (
-      status.second.laneMatchingSucceed() && std::count(
-                                               conflicting_lanes.begin(), conflicting_lanes.end(),
-                                               status.second.getLaneletPose().lanelet_id) >= 1) {
-      return true;
-    }
-  }
-  return false;
+  const auto is_occupied = [this](const auto & lanelet_id) {
+    return not other_entity_status.getIdsOnLanelet(lanelet_id).empty();
+  };
+  const auto conflicting_crosswalks = hdmap_utils->getConflictingCrosswalkIds(following_lanelets);
+  const auto conflicting_lanes = hdmap_utils->getConflictingLaneIds(following_lanelets);
+  return std::any_of(conflicting_crosswalks.begin(), conflicting_crosswalks.end(), is_occupied) or
+         std::any_of(conflicting_lanes.begin(), conflicting_lanes.end(), is_occupied);
 }
 
 auto ActionNode::calculateUpdatedEntityStatus(
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <ament_index_cpp/get_package_share_directory.hpp>
+#include <behavior_tree_plugin/behavior_tree_template.hpp>
 #include <behavior_tree_plugin/vehicle/behavior_tree.hpp>
 #include <behavior_tree_plugin/vehicle/follow_lane_sequence/follow_front_entity_action.hpp>
 #include <behavior_tree_plugin/vehicle/follow_lane_sequence/follow_lane_action.hpp>
@@ -25,8 +26,6 @@
 #include <behavior_tree_plugin/vehicle/follow_trajectory_sequence/follow_polyline_trajectory_action.hpp>
 #include <behavior_tree_plugin/vehicle/lane_change_action.hpp>
 #include <iostream>
-#include <pugixml.hpp>
-#include <sstream>
 #include <string>
 #include <traffic_simulator_msgs/msg/behavior_parameter.hpp>
 #include <utility>
@@ -35,22 +34,29 @@ namespace entity_behavior
 {
 void VehicleBehaviorTree::configure(const rclcpp::Logger & logger)
 {
-  factory_.registerNodeType<vehicle::follow_lane_sequence::FollowLaneAction>("FollowLane");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::FollowFrontEntityAction>(
-    "FollowFrontEntity");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtCrossingEntityAction>(
-    "StopAtCrossingEntity");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtStopLineAction>("StopAtStopLine");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtTrafficLightAction>(
-    "StopAtTrafficLight");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::YieldAction>("Yield");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::MoveBackwardAction>("MoveBackward");
-  factory_.registerNodeType<vehicle::FollowPolylineTrajectoryAction>("FollowPolylineTrajectory");
-  factory_.registerNodeType<vehicle::LaneChangeAction>("LaneChange");
-
-  tree_ = createBehaviorTree(
+  /// @note Built on the first call and shared by all vehicles in this process.
+  static const behavior_tree_plugin::BehaviorTreeTemplate behavior_tree_template(
     ament_index_cpp::get_package_share_directory("behavior_tree_plugin") +
-    "/config/vehicle_entity_behavior.xml");
+      "/config/vehicle_entity_behavior.xml",
+    [](BT::BehaviorTreeFactory & factory) {
+      factory.registerNodeType<vehicle::follow_lane_sequence::FollowLaneAction>("FollowLane");
+      factory.registerNodeType<vehicle::follow_lane_sequence::FollowFrontEntityAction>(
+        "FollowFrontEntity");
+      factory.registerNodeType<vehicle::follow_lane_sequence::StopAtCrossingEntityAction>(
+        "StopAtCrossingEntity");
+      factory.registerNodeType<vehicle::follow_lane_sequence::StopAtStopLineAction>(
+        "StopAtStopLine");
+      factory.registerNodeType<vehicle::follow_lane_sequence::StopAtTrafficLightAction>(
+        "StopAtTrafficLight");
+      factory.registerNodeType<vehicle::follow_lane_sequence::YieldAction>("Yield");
+      factory.registerNodeType<vehicle::follow_lane_sequence::MoveBackwardAction>(
+        "MoveBackward");
+      factory.registerNodeType<vehicle::FollowPolylineTrajectoryAction>(
+        "FollowPolylineTrajectory");
+      factory.registerNodeType<vehicle::LaneChangeAction>("LaneChange");
+    });
+
+  tree_ = behavior_tree_template.instantiate();
 
   logging_event_ptr_ =
     std::make_unique<behavior_tree_plugin::LoggingEvent>(tree_.rootNode(), logger);
@@ -62,42 +68,6 @@ void VehicleBehaviorTree::configure(const rclcpp::Logger & logger)
   setRequest(traffic_simulator::behavior::Request::NONE);
 }
 
-auto VehicleBehaviorTree::createBehaviorTree(const std::string & format_path) -> BT::Tree
-{
-  auto xml_doc = pugi::xml_document();
-  xml_doc.load_file(format_path.c_str());
-
-  class XMLTreeWalker : public pugi::xml_tree_walker
-  {
-  public:
-    explicit XMLTreeWalker(const BT::TreeNodeManifest & manifest) : manifest_(manifest) {}
-
-  private:
-    bool for_each(pugi::xml_node & node) final
-    {
-      if (node.name() == manifest_.registration_ID) {
-        for (const auto & [port, info] : manifest_.ports) {
-          node.append_attribute(port.c_str()) = std::string("{" + port + "}").c_str();
-        }
-      }
-      return true;
-    }
-
-    const BT::TreeNodeManifest & manifest_;
-  };
-
-  for (const auto & [id, manifest] : factory_.manifests()) {
-    if (factory_.builtinNodes().count(id) == 0) {
-      auto walker = XMLTreeWalker(manifest);
-      xml_doc.traverse(walker);
-    }
-  }
-
-  auto xml_str = std::stringstream();
-  xml_doc.save(xml_str);
-  return factory_.createTreeFromText(xml_str.str());
-}
-
 auto VehicleBehaviorTree::getBehaviorParameter() -> traffic_simulator_msgs::msg::BehaviorParameter
 {
   return tree_.rootBlackboard()->get<traffic_simulator_msgs::msg::BehaviorParameter>(
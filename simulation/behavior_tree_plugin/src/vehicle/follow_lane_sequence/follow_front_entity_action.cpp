@@ -61,8 +61,7 @@ const traffic_simulator_msgs::msg::WaypointsArray FollowFrontEntityAction::calcu
     const auto lanelet_pose = entity_status->getLaneletPose();
     waypoints.waypoints = reference_trajectory->getTrajectory(
       lanelet_pose.s, lanelet_pose.s + horizon, 1.0, lanelet_pose.offset);
-    trajectory = std::make_unique<math::geometry::CatmullRomSubspline>(
-      reference_trajectory, lanelet_pose.s, lanelet_pose.s + horizon);
+    trajectory.emplace(*reference_trajectory, lanelet_pose.s, lanelet_pose.s + horizon);
     return waypoints;
   } else {
     return traffic_simulator_msgs::msg::WaypointsArray();
@@ -87,7 +86,7 @@ BT::NodeStatus FollowFrontEntityAction::tick()
   if (waypoints.waypoints.empty()) {
     return BT::NodeStatus::FAILURE;
   }
-  if (trajectory == nullptr) {
+  if (!trajectory) {
     return BT::NodeStatus::FAILURE;
   }
   auto distance_to_stopline = hdmap_utils->getDistanceToStopLine(route_lanelets, *trajectory);
@@ -47,8 +47,7 @@ const traffic_simulator_msgs::msg::WaypointsArray FollowLaneAction::calculateWay
     const auto lanelet_pose = entity_status->getLaneletPose();
     waypoints.waypoints = reference_trajectory->getTrajectory(
       lanelet_pose.s, lanelet_pose.s + getHorizon(), 1.0, lanelet_pose.offset);
-    trajectory = std::make_unique<math::geometry::CatmullRomSubspline>(
-      reference_trajectory, lanelet_pose.s, lanelet_pose.s + getHorizon());
+    trajectory.emplace(*reference_trajectory, lanelet_pose.s, lanelet_pose.s + getHorizon());
     return waypoints;
   } else {
     return traffic_simulator_msgs::msg::WaypointsArray();
@@ -87,7 +86,7 @@ BT::NodeStatus FollowLaneAction::tick()
     if (getRightOfWayEntities(route_lanelets).size() != 0) {
       return BT::NodeStatus::FAILURE;
     }
-    if (trajectory == nullptr) {
+    if (!trajectory) {
       return BT::NodeStatus::FAILURE;
     }
     auto distance_to_front_entity = getDistanceToFrontEntity(*trajectory);
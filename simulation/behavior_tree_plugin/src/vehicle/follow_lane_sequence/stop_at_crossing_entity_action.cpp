@@ -62,8 +62,7 @@ const traffic_simulator_msgs::msg::WaypointsArray StopAtCrossingEntityAction::ca
     const auto lanelet_pose = entity_status->getLaneletPose();
     waypoints.waypoints = reference_trajectory->getTrajectory(
       lanelet_pose.s, lanelet_pose.s + getHorizon(), 1.0, lanelet_pose.offset);
-    trajectory = std::make_unique<math::geometry::CatmullRomSubspline>(
-      reference_trajectory, lanelet_pose.s, lanelet_pose.s + getHorizon());
+    trajectory.emplace(*reference_trajectory, lanelet_pose.s, lanelet_pose.s + getHorizon());
     return waypoints;
   } else {
     return traffic_simulator_msgs::msg::WaypointsArray();
@@ -108,7 +107,7 @@ BT::NodeStatus StopAtCrossingEntityAction::tick()
   if (waypoints.waypoints.empty()) {
     return BT::NodeStatus::FAILURE;
   }
-  if (trajectory == nullptr) {
+  if (!trajectory) {
     return BT::NodeStatus::FAILURE;
   }
   distance_to_stop_target_ = getDistanceToConflictingEntity(route_lanelets, *trajectory);
@@ -37,10 +37,14 @@ void VehicleActionNode::getBlackBoardValues()
         "vehicle_parameters", vehicle_parameters)) {
     THROW_SIMULATION_ERROR("failed to get input vehicle_parameters in VehicleActionNode");
   }
+  const auto previous_reference_trajectory = reference_trajectory;
   if (!getInput<std::shared_ptr<math::geometry::CatmullRomSpline>>(
         "reference_trajectory", reference_trajectory)) {
     THROW_SIMULATION_ERROR("failed to get input reference_trajectory in VehicleActionNode");
   }
+  if (reference_trajectory != previous_reference_trajectory) {
+    trajectory.reset();
+  }
 }
 
 auto VehicleActionNode::calculateUpdatedEntityStatus(double target_speed) const
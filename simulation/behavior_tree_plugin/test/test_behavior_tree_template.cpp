@@ -0,0 +1,79 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <behavior_tree_plugin/pedestrian/behavior_tree.hpp>
+#include <behavior_tree_plugin/vehicle/behavior_tree.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <rclcpp/rclcpp.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Measure how long configuring the behavior tree of a spawned entity takes.
+ * @note The first entity builds the shared template, the following ones only instantiate it.
+ */
+template <typename BehaviorTree>
+auto measureSpawnLatency(const std::string & label, std::size_t count)
+  -> std::vector<std::unique_ptr<BehaviorTree>>
+{
+  std::vector<std::unique_ptr<BehaviorTree>> trees;
+  std::chrono::nanoseconds first{0};
+  std::chrono::nanoseconds rest{0};
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto begin = std::chrono::steady_clock::now();
+    trees.push_back(std::make_unique<BehaviorTree>());
+    trees.back()->configure(rclcpp::get_logger(label));
+    (i == 0 ? first : rest) += std::chrono::steady_clock::now() - begin;
+  }
+  std::cout << label << " spawn latency: first "
+            << std::chrono::duration<double, std::micro>(first).count() << " us, average of rest "
+            << std::chrono::duration<double, std::micro>(rest).count() / (count - 1) << " us"
+            << std::endl;
+  return trees;
+}
+
+TEST(BehaviorTreeTemplate, VehicleSpawnLatency)
+{
+  const auto trees = measureSpawnLatency<entity_behavior::VehicleBehaviorTree>("vehicle", 100);
+  for (std::size_t i = 0; i < trees.size(); ++i) {
+    trees[i]->setCurrentTime(static_cast<double>(i));
+  }
+  for (std::size_t i = 0; i < trees.size(); ++i) {
+    EXPECT_DOUBLE_EQ(trees[i]->getCurrentTime(), static_cast<double>(i));
+    EXPECT_EQ(trees[i]->getRequest(), traffic_simulator::behavior::Request::NONE);
+  }
+}
+
+TEST(BehaviorTreeTemplate, PedestrianSpawnLatency)
+{
+  const auto trees =
+    measureSpawnLatency<entity_behavior::PedestrianBehaviorTree>("pedestrian", 100);
+  for (std::size_t i = 0; i < trees.size(); ++i) {
+    trees[i]->setCurrentTime(static_cast<double>(i));
+  }
+  for (std::size_t i = 0; i < trees.size(); ++i) {
+    EXPECT_DOUBLE_EQ(trees[i]->getCurrentTime(), static_cast<double>(i));
+    EXPECT_EQ(trees[i]->getRequest(), traffic_simulator::behavior::Request::NONE);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
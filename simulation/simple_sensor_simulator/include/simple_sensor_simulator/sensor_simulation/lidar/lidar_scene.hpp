@@ -0,0 +1,93 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__LIDAR_SCENE_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__LIDAR_SCENE_HPP_
+
+#include <embree3/rtcore.h>
+#include <simulation_api_schema.pb.h>
+
+#include <array>
+#include <geometry_msgs/msg/pose.hpp>
+#include <optional>
+#include <string>
+#include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+/**
+ * @brief Embree scene of the boxes of the entities, built once per frame and shared read-only by
+ * all lidars.
+ * @note Every box is an instance of one unit box mesh, scaled to its dimensions by its transform,
+ * so a box costs no mesh of its own. A box is added when it is first updated, moved in place when
+ * its transform changes, and removed when it is not updated between two commits.
+ * The static geometry of the lanelet map, if set, is built once into a scene of its own and added
+ * as one more instance, so that committing the scene every frame costs only the moving boxes.
+ */
+class LidarScene
+{
+public:
+  LidarScene();
+  explicit LidarScene(std::string embree_config);
+  ~LidarScene();
+  LidarScene(const LidarScene &) = delete;
+  LidarScene & operator=(const LidarScene &) = delete;
+  /**
+   * @brief Update the boxes of all entities and commit the scene.
+   */
+  void update(const std::vector<traffic_simulator_msgs::EntityStatus> & status);
+  void updateBox(
+    const std::string & name, double depth, double width, double height,
+    const geometry_msgs::msg::Pose & pose);
+  /**
+   * @brief Remove the boxes which were not updated since the previous commit and build the scene.
+   */
+  void commit();
+  /**
+   * @brief Build the static geometry of the lanelet map, replacing the previous one if any.
+   */
+  void setMap(const hdmap_utils::HdMapUtils & hdmap_utils);
+  void clearMap();
+  RTCScene getScene() const { return scene_; }
+  /// @note Id of the instance of the box of the entity, as reported in hit.instID by Embree.
+  std::optional<unsigned int> findInstanceId(const std::string & name) const;
+  /// @note Name of the entity of the instance, or std::nullopt for the instance of the map.
+  std::optional<std::string> findName(unsigned int instance_id) const;
+
+private:
+  struct Instance
+  {
+    RTCGeometry geometry;
+    unsigned int geometry_id;
+    std::array<float, 12> transform;
+    bool is_committed;
+    bool is_updated;
+  };
+  RTCDevice device_;
+  /// @note Scene of the unit box mesh instanced by all boxes.
+  RTCScene box_scene_;
+  RTCScene scene_;
+  std::unordered_map<std::string, Instance> instances_;
+  std::unordered_map<unsigned int, std::string> geometry_ids_;
+  /// @note Scene of the static geometry of the lanelet map, and its instance in scene_.
+  RTCScene map_scene_ = nullptr;
+  RTCGeometry map_instance_ = nullptr;
+  unsigned int map_instance_id_ = RTC_INVALID_GEOMETRY_ID;
+};
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__LIDAR_SCENE_HPP_
@@ -21,8 +21,11 @@
 #include <queue>
 #include <rclcpp/rclcpp.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
+#include <simple_sensor_simulator/sensor_simulation/lidar/lidar_scene.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
 #include <string>
+#include <traffic_simulator/helper/thread_pool.hpp>
+#include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
@@ -36,18 +39,38 @@ protected:
   Raycaster raycaster_;
   std::vector<std::string> detected_objects_;
 
+  /// @note Shared by all lidars, which are finished one after another.
+  const std::shared_ptr<traffic_simulator::helper::ThreadPool> thread_pool_;
+
+  bool is_scanning_ = false;
+
   explicit LidarSensorBase(
-    const double last_update_stamp, const simulation_api_schema::LidarConfiguration & configuration)
-  : last_update_stamp_(last_update_stamp), configuration_(configuration)
+    const double last_update_stamp, const simulation_api_schema::LidarConfiguration & configuration,
+    const std::shared_ptr<traffic_simulator::helper::ThreadPool> & thread_pool)
+  : last_update_stamp_(last_update_stamp), configuration_(configuration), thread_pool_(thread_pool)
   {
   }
 
 public:
   virtual ~LidarSensorBase() = default;
 
-  virtual auto update(
-    const double, const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &)
-    -> void = 0;
+  auto isScanDue(const double current_time) const -> bool;
+
+  /**
+   * @brief Prepare the raycast of a scan if a scan is due at current_time.
+   * @return true if a scan was prepared; its chunks are then to be intersected on the raycaster
+   * before update is called.
+   */
+  auto prepareScan(
+    const double current_time, const std::vector<traffic_simulator_msgs::EntityStatus> & status,
+    const LidarScene & scene) -> bool;
+
+  auto getRaycaster() -> Raycaster & { return raycaster_; }
+
+  /**
+   * @brief Finish the prepared scan if any, and publish the scans whose delay has elapsed.
+   */
+  virtual auto update(const double, const rclcpp::Time &) -> void = 0;
 
   auto getDetectedObjects() const -> const std::vector<std::string> & { return detected_objects_; }
 };
@@ -57,48 +80,41 @@ class LidarSensor : public LidarSensorBase
 {
   const typename rclcpp::Publisher<T>::SharedPtr publisher_ptr_;
 
-  std::queue<std::pair<sensor_msgs::msg::PointCloud2, double>> queue_pointcloud_;
+  std::queue<std::pair<std::unique_ptr<T>, double>> queue_pointcloud_;
 
-  auto raycast(const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &)
-    -> T;
+  auto raycast(const rclcpp::Time &) -> T;
 
 public:
   explicit LidarSensor(
     const double current_time, const simulation_api_schema::LidarConfiguration & configuration,
-    const typename rclcpp::Publisher<T>::SharedPtr & publisher_ptr)
-  : LidarSensorBase(current_time, configuration), publisher_ptr_(publisher_ptr)
+    const typename rclcpp::Publisher<T>::SharedPtr & publisher_ptr,
+    const std::shared_ptr<traffic_simulator::helper::ThreadPool> & thread_pool)
+  : LidarSensorBase(current_time, configuration, thread_pool), publisher_ptr_(publisher_ptr)
   {
     raycaster_.setDirection(configuration);
   }
 
-  auto update(
-    const double current_time, const std::vector<traffic_simulator_msgs::EntityStatus> & status,
-    const rclcpp::Time & stamp) -> void override
+  auto update(const double current_time, const rclcpp::Time & stamp) -> void override
   {
-    if (current_time - last_update_stamp_ - configuration_.scan_duration() >= -0.002) {
-      last_update_stamp_ = current_time;
-      queue_pointcloud_.push(std::make_pair(raycast(status, stamp), current_time));
-    } else {
-      detected_objects_ = {};
+    if (is_scanning_) {
+      is_scanning_ = false;
+      queue_pointcloud_.emplace(std::make_unique<T>(raycast(stamp)), current_time);
     }
 
     if (
       !queue_pointcloud_.empty() &&
       current_time - queue_pointcloud_.front().second >= configuration_.lidar_sensor_delay()) {
-      const auto pointcloud = queue_pointcloud_.front().first;
+      /// @note Ownership is handed to the publisher, so the point cloud is not copied to publish
+      /// it. PointCloud2 is not of bounded size, so it cannot be published as a loaned message.
+      auto pointcloud = std::move(queue_pointcloud_.front().first);
       queue_pointcloud_.pop();
-      publisher_ptr_->publish(pointcloud);
+      publisher_ptr_->publish(std::move(pointcloud));
     }
   }
-
-private:
-  // Override
-  Raycaster raycaster_;
 };
 
 template <>
-auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(
-  const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &)
+auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(const rclcpp::Time &)
   -> sensor_msgs::msg::PointCloud2;
 }  // namespace simple_sensor_simulator
 
@@ -16,45 +16,60 @@
 #define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__RAYCASTER_HPP_
 
 #include <embree3/rtcore.h>
-#include <pcl_conversions/pcl_conversions.h>
 #include <quaternion_operation/quaternion_operation.h>
 
+#include <cstddef>
 #include <geometry_msgs/msg/pose.hpp>
 #include <geometry_msgs/msg/vector3.hpp>
 #include <memory>
+#include <optional>
 #include <random>
 #include <sensor_msgs/msg/point_cloud2.hpp>
-#include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
-#include <simple_sensor_simulator/sensor_simulation/primitives/primitive.hpp>
+#include <simple_sensor_simulator/sensor_simulation/lidar/lidar_scene.hpp>
 #include <string>
-#include <unordered_map>
+#include <traffic_simulator/helper/thread_pool.hpp>
 #include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
 {
+/**
+ * @brief Raycaster of a lidar, tracing its rays against the scene shared by all lidars.
+ * @note A raycast is split into prepare, intersect and finish, so that the chunks of the raycasts
+ * of all lidars can be traced in one parallel loop. Chunks are contiguous ranges of rays, and the
+ * hits of all chunks are copied into the data of the point cloud message at offsets given by a
+ * prefix sum of their counts.
+ * Within a chunk, neighbouring rays are traced together as packets, which Embree traverses with
+ * SIMD instructions.
+ */
 class Raycaster
 {
 public:
   Raycaster();
-  explicit Raycaster(std::string embree_config);
-  ~Raycaster();
-  template <typename T, typename... Ts>
-  void addPrimitive(std::string name, Ts &&... xs)
-  {
-    if (primitive_ptrs_.count(name) != 0) {
-      throw std::runtime_error("primitive " + name + " already exist.");
-    }
-    auto primitive_ptr = std::make_unique<T>(std::forward<Ts>(xs)...);
-    primitive_ptrs_.emplace(name, std::move(primitive_ptr));
-  }
-  const sensor_msgs::msg::PointCloud2 raycast(
+  /**
+   * @brief Start a raycast from origin, ignoring the box of the entity named excluded_name.
+   * @note The scene must not be modified until the raycast is finished.
+   */
+  void prepare(
+    const LidarScene & scene, const geometry_msgs::msg::Pose & origin,
+    const std::optional<std::string> & excluded_name, double max_distance = 300,
+    double min_distance = 0);
+  std::size_t getChunkCount() const;
+  /// @note Different chunks of a prepared raycast may be intersected concurrently.
+  void intersect(std::size_t chunk);
+  sensor_msgs::msg::PointCloud2 finish(
     const std::string & frame_id, const rclcpp::Time & stamp,
-    const geometry_msgs::msg::Pose & origin, double max_distance = 300, double min_distance = 0);
+    traffic_simulator::helper::ThreadPool & thread_pool);
   const std::vector<std::string> & getDetectedObject() const;
   void setDirection(
     const simulation_api_schema::LidarConfiguration & configuration,
     double horizontal_angle_start = 0, double horizontal_angle_end = 2 * M_PI);
+  /**
+   * @brief Trace rays in packets with rtcIntersect16 (default) or one by one with rtcIntersect1.
+   * @note Both trace the same rays and find the same hits. Tracing one by one is kept as the
+   * reference that the packet path is tested and benchmarked against.
+   */
+  void setRayPacketsEnabled(bool enabled) { ray_packets_enabled_ = enabled; }
 
 private:
   std::vector<geometry_msgs::msg::Quaternion> getDirections(
@@ -65,57 +80,37 @@ private:
   double previous_horizontal_angle_end_;
   double previous_horizontal_resolution_;
   std::vector<double> previous_vertical_angles_;
-  std::unordered_map<std::string, std::unique_ptr<primitives::Primitive>> primitive_ptrs_;
-  RTCDevice device_;
-  RTCScene scene_;
+  /// @note Layout of a point in the data of the point cloud message.
+  struct Point
+  {
+    float x;
+    float y;
+    float z;
+    float intensity;
+  };
+  const LidarScene * scene_ = nullptr;
+  geometry_msgs::msg::Pose origin_;
+  Eigen::Matrix3f orientation_matrix_;
+  double max_distance_ = 0;
+  double min_distance_ = 0;
+  unsigned int excluded_instance_id_ = RTC_INVALID_GEOMETRY_ID;
   std::random_device seed_gen_;
   std::default_random_engine engine_;
   std::vector<std::string> detected_objects_;
-  std::unordered_map<unsigned int, std::string> geometry_ids_;
-  std::vector<Eigen::Matrix3d> rotation_matrices_;
-
-  static void intersect(
-    int thread_id, int thread_count, RTCScene scene,
-    pcl::PointCloud<pcl::PointXYZI>::Ptr thread_cloud, RTCIntersectContext context,
-    geometry_msgs::msg::Pose origin,
-    std::reference_wrapper<std::set<unsigned int>> ref_thread_detected_ids, double max_distance,
-    double min_distance,
-    std::reference_wrapper<const std::vector<Eigen::Matrix3d>> ref_rotation_matrices)
-  {
-    auto & rotation_matrices = ref_rotation_matrices.get();
-    auto & thread_detected_ids = ref_thread_detected_ids.get();
-    const auto orientation_matrix = quaternion_operation::getRotationMatrix(origin.orientation);
-    for (unsigned int i = thread_id; i < rotation_matrices.size(); i += thread_count) {
-      RTCRayHit rayhit = {};
-      rayhit.ray.org_x = origin.position.x;
-      rayhit.ray.org_y = origin.position.y;
-      rayhit.ray.org_z = origin.position.z;
-      // make raycast interact with all objects
-      rayhit.ray.mask = 0b11111111'11111111'11111111'11111111;
-      rayhit.ray.tfar = max_distance;
-      rayhit.ray.tnear = min_distance;
-      rayhit.ray.flags = false;
-
-      const auto rotation_mat = orientation_matrix * rotation_matrices.at(i);
-      rayhit.ray.dir_x = rotation_mat(0);
-      rayhit.ray.dir_y = rotation_mat(1);
-      rayhit.ray.dir_z = rotation_mat(2);
-      rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
-      rtcIntersect1(scene, &context, &rayhit);
+  /// @note Directions of the rays in the sensor frame, as structure of arrays to fill ray packets.
+  std::vector<float> directions_x_;
+  std::vector<float> directions_y_;
+  std::vector<float> directions_z_;
 
-      if (rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID) {
-        double distance = rayhit.ray.tfar;
-        pcl::PointXYZI p;
-        {
-          p.x = rotation_matrices.at(i)(0) * distance;
-          p.y = rotation_matrices.at(i)(1) * distance;
-          p.z = rotation_matrices.at(i)(2) * distance;
-        }
-        thread_cloud->emplace_back(p);
-        thread_detected_ids.insert(rayhit.hit.geomID);
-      }
-    }
-  }
+  /// @note Rays are cast in contiguous chunks of this many rays, one chunk per parallel task.
+  static constexpr std::size_t rays_per_chunk = 1024;
+  /// @note Rays of a chunk are traced in packets of this many rays with rtcIntersect16.
+  static constexpr std::size_t rays_per_packet = 16;
+  static_assert(rays_per_chunk % rays_per_packet == 0);
+  bool ray_packets_enabled_ = true;
+  /// @note Hits of each chunk, reused between raycasts to avoid allocations.
+  std::vector<std::vector<Point>> chunk_points_;
+  std::vector<std::vector<unsigned int>> chunk_detected_ids_;
 };
 }  // namespace simple_sensor_simulator
 
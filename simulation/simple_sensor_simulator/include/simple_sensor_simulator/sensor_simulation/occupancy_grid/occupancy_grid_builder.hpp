@@ -53,6 +53,12 @@ public:
    */
   auto add(const PrimitiveType & primitive) -> void;
 
+  /**
+   * @brief Mark invisible area and occupied area of boxes
+   * @param boxes
+   */
+  auto add(const std::vector<primitives::Box> & boxes) -> void;
+
   /**
    * @brief Reset all internal state
    * @param origin
@@ -104,6 +110,20 @@ private:
    */
   std::vector<int32_t> min_cols_, max_cols_;
 
+  /**
+   * @brief Flat buffer of convex hulls of added primitives and offsets of each convex hull
+   * @note These vectors are declared as members to reuse allocated memory
+   */
+  PolygonType convex_hulls_;
+  std::vector<size_t> convex_hull_offsets_;
+
+  /**
+   * @brief Mark invisible area and occupied area of convex hull
+   * @param first Iterator to the first point of convex hull in world coordinate
+   * @param last Iterator past the last point of convex hull in world coordinate
+   */
+  auto addConvexHull(PolygonType::const_iterator first, PolygonType::const_iterator last) -> void;
+
   /**
    * @brief Mark grid area of convex hull
    * @param grid Grid to be marked
@@ -136,10 +156,12 @@ private:
 
   /**
    * @brief Construct a convex hull of the area occupied with primitive
-   * @param primitive
+   * @param first Iterator to the first point of convex hull of primitive in world coordinate
+   * @param last Iterator past the last point of convex hull of primitive in world coordinate
    * @return Convex hull polygon
    */
-  inline auto makeOccupiedArea(const PrimitiveType & primitive) const -> PolygonType;
+  inline auto makeOccupiedArea(
+    PolygonType::const_iterator first, PolygonType::const_iterator last) const -> PolygonType;
 
   /**
    * @brief Construct a convex hull of the area made invisible by the occupied area
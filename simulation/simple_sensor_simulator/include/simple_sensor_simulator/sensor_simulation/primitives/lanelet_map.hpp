@@ -0,0 +1,47 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__PRIMITIVES__LANELET_MAP_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__PRIMITIVES__LANELET_MAP_HPP_
+
+#include <geometry_msgs/msg/point.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/primitive.hpp>
+#include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+namespace primitives
+{
+/**
+ * @brief Static geometry of a lanelet map seen by lidars.
+ * @note Road surfaces are triangulated between the left and right bounds of every lanelet, and
+ * curbs and walls are line strings extruded upward by a height depending on their type.
+ */
+class LaneletMap : public Primitive
+{
+public:
+  explicit LaneletMap(const hdmap_utils::HdMapUtils & hdmap_utils);
+  ~LaneletMap() = default;
+
+private:
+  void appendRoadSurface(
+    const std::vector<geometry_msgs::msg::Point> & left_bound,
+    const std::vector<geometry_msgs::msg::Point> & right_bound);
+  void appendWall(const std::vector<geometry_msgs::msg::Point> & line_string, double height);
+};
+}  // namespace primitives
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__PRIMITIVES__LANELET_MAP_HPP_
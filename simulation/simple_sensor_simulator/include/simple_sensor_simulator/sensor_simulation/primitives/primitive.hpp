@@ -18,6 +18,7 @@
 #include <embree3/rtcore.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <geometry/polygon/polygon.hpp>
 #include <geometry_msgs/msg/pose.hpp>
 #include <optional>
@@ -57,9 +58,17 @@ public:
   unsigned int addToScene(RTCDevice device, RTCScene scene);
   std::vector<Vertex> getVertex() const;
   std::vector<Triangle> getTriangles() const;
+  std::size_t getTriangleCount() const;
   std::vector<geometry_msgs::msg::Point> get2DConvexHull() const;
   std::vector<geometry_msgs::msg::Point> get2DConvexHull(
     const geometry_msgs::msg::Pose & sensor_pose) const;
+  /**
+   * @brief Append 2D convex hull in world frame to the given buffer.
+   * @note If the pose only has yaw rotation, the convex hull in local frame is transformed rigidly
+   *       instead of computing the convex hull of all transformed vertices.
+   * @param hull buffer to append the convex hull to
+   */
+  void append2DConvexHull(std::vector<geometry_msgs::msg::Point> & hull) const;
   std::optional<double> getMax(const math::geometry::Axis & axis) const;
   std::optional<double> getMin(const math::geometry::Axis & axis) const;
   std::optional<double> getMax(
@@ -72,11 +81,38 @@ protected:
   std::vector<Vertex> transform(const geometry_msgs::msg::Pose & sensor_pose) const;
   std::vector<Vertex> vertices_;
   std::vector<Triangle> triangles_;
+  /**
+   * @brief Closed clockwise 2D convex hull of vertices_ in local frame.
+   * @note If empty, the convex hull is computed from all transformed vertices on each call.
+   */
+  std::vector<geometry_msgs::msg::Point> local_2d_convex_hull_;
 
 private:
   Vertex transform(const Vertex & v) const;
   Vertex transform(const Vertex & v, const geometry_msgs::msg::Pose & sensor_pose) const;
+  void append2DConvexHull(
+    const geometry_msgs::msg::Quaternion & rotation, const geometry_msgs::msg::Point & translation,
+    std::vector<geometry_msgs::msg::Point> & hull) const;
 };
+
+/**
+ * @brief Compute 2D convex hulls of all primitives in one pass into a flat buffer.
+ * @param primitives primitives to compute convex hulls of
+ * @param hulls buffer of convex hull points, reused across calls to avoid allocation
+ * @param offsets convex hull of primitives[i] is hulls[offsets[i]], ..., hulls[offsets[i + 1] - 1]
+ */
+template <typename Primitives>
+auto get2DConvexHulls(
+  const Primitives & primitives, std::vector<geometry_msgs::msg::Point> & hulls,
+  std::vector<std::size_t> & offsets) -> void
+{
+  hulls.clear();
+  offsets.assign(1, 0);
+  for (const auto & primitive : primitives) {
+    primitive.append2DConvexHull(hulls);
+    offsets.push_back(hulls.size());
+  }
+}
 }  // namespace primitives
 }  // namespace simple_sensor_simulator
 
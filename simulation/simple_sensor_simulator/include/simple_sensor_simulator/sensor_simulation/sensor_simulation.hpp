@@ -17,15 +17,19 @@
 
 #include <simulation_api_schema.pb.h>
 
+#include <algorithm>
 #include <autoware_auto_perception_msgs/msg/detected_objects.hpp>
 #include <autoware_auto_perception_msgs/msg/tracked_objects.hpp>
 #include <iomanip>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
 #include <simple_sensor_simulator/sensor_simulation/detection_sensor/detection_sensor.hpp>
+#include <simple_sensor_simulator/sensor_simulation/lidar/lidar_scene.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/traffic_lights/traffic_lights_detector.hpp>
+#include <thread>
+#include <traffic_simulator/helper/thread_pool.hpp>
 #include <vector>
 
 namespace simple_sensor_simulator
@@ -34,6 +38,8 @@ class SensorSimulation
 {
 public:
   explicit SensorSimulation(rclcpp::Node & node)
+  : raycast_thread_pool_(std::make_shared<traffic_simulator::helper::ThreadPool>(
+      std::max(std::thread::hardware_concurrency() / 2, 1u) - 1))
   {
     traffic_lights_detectors_.emplace_back(std::make_unique<traffic_lights::TrafficLightsDetector>(
       "/perception/traffic_light_recognition/traffic_signals", node));
@@ -47,7 +53,8 @@ public:
       lidar_sensors_.push_back(std::make_unique<LidarSensor<sensor_msgs::msg::PointCloud2>>(
         current_simulation_time, configuration,
         node.create_publisher<sensor_msgs::msg::PointCloud2>(
-          "/perception/obstacle_segmentation/pointcloud", 1)));
+          "/perception/obstacle_segmentation/pointcloud", 1),
+        raycast_thread_pool_));
     } else {
       std::stringstream ss;
       ss << "Unexpected architecture_type " << std::quoted(configuration.architecture_type())
@@ -95,12 +102,27 @@ public:
     }
   }
 
+  auto setLidarMap(const hdmap_utils::HdMapUtils & hdmap_utils) -> void
+  {
+    lidar_scene_.setMap(hdmap_utils);
+  }
+
+  auto clearLidarMap() -> void { lidar_scene_.clearMap(); }
+
   void updateSensorFrame(
     double current_time, const rclcpp::Time & current_ros_time,
     const std::vector<traffic_simulator_msgs::EntityStatus> & status,
     const std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> & traffic_signals);
 
 private:
+  /**
+   * @note Created once and kept for the lifetime of the simulation, so raycasts create no thread.
+   * It runs as many threads as physical cores (usually half of the virtual threads), including the
+   * thread calling the raycast, since in heavy loads hyper-threading adds little to the performance.
+   */
+  const std::shared_ptr<traffic_simulator::helper::ThreadPool> raycast_thread_pool_;
+  /// @note Built once per frame and shared read-only by all lidars.
+  LidarScene lidar_scene_;
   std::vector<std::unique_ptr<LidarSensorBase>> lidar_sensors_;
   std::vector<std::unique_ptr<DetectionSensorBase>> detection_sensors_;
   std::vector<std::unique_ptr<OccupancyGridSensorBase>> occupancy_grid_sensors_;
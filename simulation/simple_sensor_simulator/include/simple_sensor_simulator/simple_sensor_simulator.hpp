@@ -18,20 +18,22 @@
 #include <tf2/LinearMath/Quaternion.h>
 #include <tf2_ros/transform_broadcaster.h>
 
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <geographic_msgs/msg/geo_point.hpp>
 #include <geometry_msgs/msg/pose_stamped.hpp>
 #include <geometry_msgs/msg/transform_stamped.hpp>
-#include <map>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
 #include <simple_sensor_simulator/sensor_simulation/sensor_simulation.hpp>
 #include <simple_sensor_simulator/vehicle_simulation/ego_entity_simulation.hpp>
+#include <simulation_interface/entity_status_delta.hpp>
 #include <simulation_interface/zmq_multi_server.hpp>
 #include <string>
 #include <thread>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <unordered_map>
 #include <vector>
 #include <visualization_msgs/msg/marker_array.hpp>
 
@@ -99,6 +101,15 @@ private:
   auto updateEntityStatus(const simulation_api_schema::UpdateEntityStatusRequest &)
     -> simulation_api_schema::UpdateEntityStatusResponse;
 
+  auto updateEntityStatusBatch(const simulation_api_schema::UpdateEntityStatusBatchRequest &)
+    -> simulation_api_schema::UpdateEntityStatusBatchResponse;
+
+  auto updateEntityStatus(
+    const simulation_api_schema::EntityStatus &, bool npc_logic_started,
+    simulation_api_schema::UpdatedEntityStatus &) -> void;
+
+  auto step(const simulation_api_schema::StepRequest &) -> simulation_api_schema::StepResponse;
+
   auto spawnVehicleEntity(const simulation_api_schema::SpawnVehicleEntityRequest &)
     -> simulation_api_schema::SpawnVehicleEntityResponse;
 
@@ -127,6 +138,7 @@ private:
     -> simulation_api_schema::FollowPolylineTrajectoryResponse;
 
   int getSocketPort();
+  auto getServerOptions() -> zeromq::MultiServer::Options;
   std::vector<traffic_simulator_msgs::VehicleParameters> ego_vehicles_;
   std::vector<traffic_simulator_msgs::VehicleParameters> vehicles_;
   std::vector<traffic_simulator_msgs::PedestrianParameters> pedestrians_;
@@ -136,10 +148,18 @@ private:
   double current_time_;
   rclcpp::Time current_ros_time_;
   bool initialized_;
-  std::map<std::string, simulation_api_schema::EntityStatus> entity_status_;
+  /// @note Dense, in the order entities were first updated, and indexed by entity_status_indices_.
+  std::vector<traffic_simulator_msgs::EntityStatus> entity_status_;
+  std::unordered_map<std::string, std::size_t> entity_status_indices_;
   std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> traffic_signals_states_;
+  auto setEntityStatus(const simulation_api_schema::EntityStatus &) -> void;
   traffic_simulator_msgs::BoundingBox getBoundingBox(const std::string & name);
+  /// @note Decoder of UpdateEntityStatusBatchRequest::delta, which must be handled in order.
+  simulation_interface::EntityStatusDeltaDecoder entity_status_decoder_;
   zeromq::MultiServer server_;
+  /// @note Null unless the record_rpc_statistics parameter is true.
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnostics_pub_;
+  rclcpp::TimerBase::SharedPtr diagnostics_timer_;
   geographic_msgs::msg::GeoPoint getOrigin();
   std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_;
   std::shared_ptr<vehicle_simulation::EgoEntitySimulation> ego_entity_simulation_;
@@ -0,0 +1,204 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <quaternion_operation/quaternion_operation.h>
+
+#include <array>
+#include <simple_sensor_simulator/sensor_simulation/lidar/lidar_scene.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/lanelet_map.hpp>
+#include <simulation_interface/conversions.hpp>
+#include <string>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+namespace
+{
+/// @note The context filter function of Raycaster is called for hits in both scenes.
+constexpr auto scene_flags = RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION;
+
+auto makeBoxScene(RTCDevice device) -> RTCScene
+{
+  const auto scene = rtcNewScene(device);
+  rtcSetSceneFlags(scene, scene_flags);
+  primitives::Box(1, 1, 1, geometry_msgs::msg::Pose()).addToScene(device, scene);
+  rtcCommitScene(scene);
+  return scene;
+}
+
+auto makeDynamicScene(RTCDevice device) -> RTCScene
+{
+  const auto scene = rtcNewScene(device);
+  /// @note The scene is committed every frame, so a fast build is preferred to a high quality BVH.
+  rtcSetSceneFlags(scene, static_cast<RTCSceneFlags>(scene_flags | RTC_SCENE_FLAG_DYNAMIC));
+  rtcSetSceneBuildQuality(scene, RTC_BUILD_QUALITY_LOW);
+  return scene;
+}
+}  // namespace
+
+LidarScene::LidarScene()
+: device_(rtcNewDevice(nullptr)),
+  box_scene_(makeBoxScene(device_)),
+  scene_(makeDynamicScene(device_))
+{
+}
+
+LidarScene::LidarScene(std::string embree_config)
+: device_(rtcNewDevice(embree_config.c_str())),
+  box_scene_(makeBoxScene(device_)),
+  scene_(makeDynamicScene(device_))
+{
+}
+
+LidarScene::~LidarScene()
+{
+  clearMap();
+  for (const auto & [name, instance] : instances_) {
+    rtcReleaseGeometry(instance.geometry);
+  }
+  rtcReleaseScene(scene_);
+  rtcReleaseScene(box_scene_);
+  rtcReleaseDevice(device_);
+}
+
+void LidarScene::update(const std::vector<traffic_simulator_msgs::EntityStatus> & status)
+{
+  for (const auto & s : status) {
+    geometry_msgs::msg::Pose pose;
+    simulation_interface::toMsg(s.pose(), pose);
+    auto rotation = quaternion_operation::getRotationMatrix(pose.orientation);
+    geometry_msgs::msg::Point center_point;
+    simulation_interface::toMsg(s.bounding_box().center(), center_point);
+    Eigen::Vector3d center(center_point.x, center_point.y, center_point.z);
+    center = rotation * center;
+    pose.position.x = pose.position.x + center.x();
+    pose.position.y = pose.position.y + center.y();
+    pose.position.z = pose.position.z + center.z();
+    updateBox(
+      s.name(), s.bounding_box().dimensions().x(), s.bounding_box().dimensions().y(),
+      s.bounding_box().dimensions().z(), pose);
+  }
+  commit();
+}
+
+void LidarScene::updateBox(
+  const std::string & name, double depth, double width, double height,
+  const geometry_msgs::msg::Pose & pose)
+{
+  auto iter = instances_.find(name);
+  if (iter == instances_.end()) {
+    const auto geometry = rtcNewGeometry(device_, RTC_GEOMETRY_TYPE_INSTANCE);
+    rtcSetGeometryInstancedScene(geometry, box_scene_);
+    // enable raycasting
+    rtcSetGeometryMask(geometry, 0b11111111'11111111'11111111'11111111);
+    const auto geometry_id = rtcAttachGeometry(scene_, geometry);
+    geometry_ids_[geometry_id] = name;
+    iter = instances_.emplace(name, Instance{geometry, geometry_id, {}, false, false}).first;
+  }
+  /// @note Column-major 3x4 matrix scaling the unit box, then rotating and translating it.
+  const auto rotation = quaternion_operation::getRotationMatrix(pose.orientation);
+  const double scale[3] = {depth, width, height};
+  std::array<float, 12> transform;
+  for (int column = 0; column < 3; ++column) {
+    for (int row = 0; row < 3; ++row) {
+      transform[column * 3 + row] = rotation(row, column) * scale[column];
+    }
+  }
+  transform[9] = pose.position.x;
+  transform[10] = pose.position.y;
+  transform[11] = pose.position.z;
+  auto & instance = iter->second;
+  /// @note Boxes which did not move are left unmodified, so that the scene is not rebuilt if no box
+  /// moved since the previous commit.
+  if (instance.transform != transform or not instance.is_committed) {
+    rtcSetGeometryTransform(
+      instance.geometry, 0, RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR, transform.data());
+    rtcCommitGeometry(instance.geometry);
+    instance.transform = transform;
+    instance.is_committed = true;
+  }
+  instance.is_updated = true;
+}
+
+void LidarScene::commit()
+{
+  for (auto iter = instances_.begin(); iter != instances_.end();) {
+    if (auto & instance = iter->second; instance.is_updated) {
+      instance.is_updated = false;
+      ++iter;
+    } else {
+      rtcDetachGeometry(scene_, instance.geometry_id);
+      rtcReleaseGeometry(instance.geometry);
+      geometry_ids_.erase(instance.geometry_id);
+      iter = instances_.erase(iter);
+    }
+  }
+  rtcCommitScene(scene_);
+}
+
+void LidarScene::setMap(const hdmap_utils::HdMapUtils & hdmap_utils)
+{
+  clearMap();
+  primitives::LaneletMap lanelet_map(hdmap_utils);
+  if (lanelet_map.getTriangleCount() == 0) {
+    return;
+  }
+  /// @note The map is committed only once, so a high quality BVH is worth its build time.
+  map_scene_ = rtcNewScene(device_);
+  rtcSetSceneFlags(map_scene_, scene_flags);
+  rtcSetSceneBuildQuality(map_scene_, RTC_BUILD_QUALITY_HIGH);
+  lanelet_map.addToScene(device_, map_scene_);
+  rtcCommitScene(map_scene_);
+  map_instance_ = rtcNewGeometry(device_, RTC_GEOMETRY_TYPE_INSTANCE);
+  rtcSetGeometryInstancedScene(map_instance_, map_scene_);
+  // enable raycasting
+  rtcSetGeometryMask(map_instance_, 0b11111111'11111111'11111111'11111111);
+  constexpr std::array<float, 12> identity = {1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0};
+  rtcSetGeometryTransform(map_instance_, 0, RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR, identity.data());
+  rtcCommitGeometry(map_instance_);
+  map_instance_id_ = rtcAttachGeometry(scene_, map_instance_);
+}
+
+void LidarScene::clearMap()
+{
+  if (map_instance_) {
+    rtcDetachGeometry(scene_, map_instance_id_);
+    rtcReleaseGeometry(map_instance_);
+    rtcReleaseScene(map_scene_);
+    map_instance_ = nullptr;
+    map_scene_ = nullptr;
+    map_instance_id_ = RTC_INVALID_GEOMETRY_ID;
+  }
+}
+
+std::optional<unsigned int> LidarScene::findInstanceId(const std::string & name) const
+{
+  if (const auto iter = instances_.find(name); iter != instances_.end()) {
+    return iter->second.geometry_id;
+  } else {
+    return std::nullopt;
+  }
+}
+
+std::optional<std::string> LidarScene::findName(unsigned int instance_id) const
+{
+  if (const auto iter = geometry_ids_.find(instance_id); iter != geometry_ids_.end()) {
+    return iter->second;
+  } else {
+    return std::nullopt;
+  }
+}
+}  // namespace simple_sensor_simulator
@@ -12,10 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <quaternion_operation/quaternion_operation.h>
-
 #include <memory>
-#include <optional>
 #include <simple_sensor_simulator/exception.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
 #include <simulation_interface/conversions.hpp>
@@ -24,42 +21,39 @@
 
 namespace simple_sensor_simulator
 {
-template <>
-auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(
-  const std::vector<traffic_simulator_msgs::EntityStatus> & status, const rclcpp::Time & stamp)
-  -> sensor_msgs::msg::PointCloud2
+auto LidarSensorBase::isScanDue(const double current_time) const -> bool
 {
-  std::optional<geometry_msgs::msg::Pose> ego_pose;
-  for (const auto & s : status) {
-    if (configuration_.entity() == s.name()) {
-      geometry_msgs::msg::Pose pose;
-      simulation_interface::toMsg(s.pose(), pose);
-      ego_pose = pose;
-    } else {
-      geometry_msgs::msg::Pose pose;
-      simulation_interface::toMsg(s.pose(), pose);
-      auto rotation = quaternion_operation::getRotationMatrix(pose.orientation);
-      geometry_msgs::msg::Point center_point;
-      simulation_interface::toMsg(s.bounding_box().center(), center_point);
-      Eigen::Vector3d center(center_point.x, center_point.y, center_point.z);
-      center = rotation * center;
-      pose.position.x = pose.position.x + center.x();
-      pose.position.y = pose.position.y + center.y();
-      pose.position.z = pose.position.z + center.z();
-      raycaster_.addPrimitive<simple_sensor_simulator::primitives::Box>(
-        s.name(), s.bounding_box().dimensions().x(), s.bounding_box().dimensions().y(),
-        s.bounding_box().dimensions().z(), pose);
-    }
-  }
-  if (ego_pose) {
-    std::vector<double> vertical_angles;
-    for (const auto v : configuration_.vertical_angles()) {
-      vertical_angles.emplace_back(v);
+  return current_time - last_update_stamp_ - configuration_.scan_duration() >= -0.002;
+}
+
+auto LidarSensorBase::prepareScan(
+  const double current_time, const std::vector<traffic_simulator_msgs::EntityStatus> & status,
+  const LidarScene & scene) -> bool
+{
+  if (isScanDue(current_time)) {
+    for (const auto & s : status) {
+      if (configuration_.entity() == s.name()) {
+        geometry_msgs::msg::Pose pose;
+        simulation_interface::toMsg(s.pose(), pose);
+        last_update_stamp_ = current_time;
+        raycaster_.prepare(scene, pose, configuration_.entity());
+        is_scanning_ = true;
+        return true;
+      }
     }
-    const auto pointcloud = raycaster_.raycast("base_link", stamp, ego_pose.value());
-    detected_objects_ = raycaster_.getDetectedObject();
-    return pointcloud;
+    throw simple_sensor_simulator::SimulationRuntimeError("failed to found ego vehicle");
+  } else {
+    detected_objects_ = {};
+    return false;
   }
-  throw simple_sensor_simulator::SimulationRuntimeError("failed to found ego vehicle");
+}
+
+template <>
+auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(const rclcpp::Time & stamp)
+  -> sensor_msgs::msg::PointCloud2
+{
+  auto pointcloud = raycaster_.finish("base_link", stamp, *thread_pool_);
+  detected_objects_ = raycaster_.getDetectedObject();
+  return pointcloud;
 }
 }  // namespace simple_sensor_simulator
@@ -15,9 +15,15 @@
 #include <quaternion_operation/quaternion_operation.h>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
 #include <iostream>
-#include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
+#include <sensor_msgs/msg/point_field.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -25,27 +31,65 @@
 
 namespace simple_sensor_simulator
 {
-Raycaster::Raycaster()
-: primitive_ptrs_(0),
-  device_(rtcNewDevice(nullptr)),
-  scene_(rtcNewScene(device_)),
-  engine_(seed_gen_())
+namespace
 {
+auto makePointField(const std::string & name, std::uint32_t offset) -> sensor_msgs::msg::PointField
+{
+  sensor_msgs::msg::PointField field;
+  field.name = name;
+  field.offset = offset;
+  field.datatype = sensor_msgs::msg::PointField::FLOAT32;
+  field.count = 1;
+  return field;
 }
 
-Raycaster::Raycaster(std::string embree_config)
-: primitive_ptrs_(0),
-  device_(rtcNewDevice(embree_config.c_str())),
-  scene_(rtcNewScene(device_)),
-  engine_(seed_gen_())
+/// @note Extended intersect context, passed by Embree to the context filter function.
+struct IntersectContext
+{
+  RTCIntersectContext context;
+  unsigned int excluded_instance_id;
+};
+
+/// @note Ignore hits on the box of the entity the lidar is attached to.
+void filterExcludedInstance(const RTCFilterFunctionNArguments * args)
 {
+  const auto context = reinterpret_cast<const IntersectContext *>(args->context);
+  for (unsigned int i = 0; i < args->N; ++i) {
+    if (
+      args->valid[i] != 0 and
+      RTCHitN_instID(args->hit, args->N, i, 0) == context->excluded_instance_id) {
+      args->valid[i] = 0;
+    }
+  }
 }
 
-Raycaster::~Raycaster()
+/// @note Trace one lane of a ray packet with rtcIntersect1, writing its hit back into the packet.
+void intersectLane(
+  RTCScene scene, RTCIntersectContext & context, RTCRayHit16 & rayhit, std::size_t lane)
 {
-  rtcReleaseScene(scene_);
-  rtcReleaseDevice(device_);
+  RTCRayHit single;
+  single.ray.org_x = rayhit.ray.org_x[lane];
+  single.ray.org_y = rayhit.ray.org_y[lane];
+  single.ray.org_z = rayhit.ray.org_z[lane];
+  single.ray.tnear = rayhit.ray.tnear[lane];
+  single.ray.dir_x = rayhit.ray.dir_x[lane];
+  single.ray.dir_y = rayhit.ray.dir_y[lane];
+  single.ray.dir_z = rayhit.ray.dir_z[lane];
+  single.ray.time = rayhit.ray.time[lane];
+  single.ray.tfar = rayhit.ray.tfar[lane];
+  single.ray.mask = rayhit.ray.mask[lane];
+  single.ray.id = rayhit.ray.id[lane];
+  single.ray.flags = rayhit.ray.flags[lane];
+  single.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+  single.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
+  rtcIntersect1(scene, &context, &single);
+  rayhit.ray.tfar[lane] = single.ray.tfar;
+  rayhit.hit.geomID[lane] = single.hit.geomID;
+  rayhit.hit.instID[0][lane] = single.hit.instID[0];
 }
+}  // namespace
+
+Raycaster::Raycaster() : engine_(seed_gen_()) {}
 
 void Raycaster::setDirection(
   const simulation_api_schema::LidarConfiguration & configuration, double horizontal_angle_start,
@@ -59,9 +103,14 @@ void Raycaster::setDirection(
   auto quat_directions = getDirections(
     vertical_angles, horizontal_angle_start, horizontal_angle_end,
     configuration.horizontal_resolution());
-  rotation_matrices_.clear();
+  directions_x_.clear();
+  directions_y_.clear();
+  directions_z_.clear();
   for (const auto & q : quat_directions) {
-    rotation_matrices_.push_back(quaternion_operation::getRotationMatrix(q));
+    const auto rotation_mat = quaternion_operation::getRotationMatrix(q);
+    directions_x_.push_back(rotation_mat(0, 0));
+    directions_y_.push_back(rotation_mat(1, 0));
+    directions_z_.push_back(rotation_mat(2, 0));
   }
 }
 
@@ -98,55 +147,140 @@ std::vector<geometry_msgs::msg::Quaternion> Raycaster::getDirections(
 
 const std::vector<std::string> & Raycaster::getDetectedObject() const { return detected_objects_; }
 
-const sensor_msgs::msg::PointCloud2 Raycaster::raycast(
-  const std::string & frame_id, const rclcpp::Time & stamp, const geometry_msgs::msg::Pose & origin,
-  double max_distance, double min_distance)
+void Raycaster::prepare(
+  const LidarScene & scene, const geometry_msgs::msg::Pose & origin,
+  const std::optional<std::string> & excluded_name, double max_distance, double min_distance)
 {
   detected_objects_ = {};
-  pcl::PointCloud<pcl::PointXYZI>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZI>());
-  for (auto & pair : primitive_ptrs_) {
-    auto id = pair.second->addToScene(device_, scene_);
-    geometry_ids_.insert({id, pair.first});
+  scene_ = &scene;
+  origin_ = origin;
+  orientation_matrix_ = quaternion_operation::getRotationMatrix(origin.orientation).cast<float>();
+  max_distance_ = max_distance;
+  min_distance_ = min_distance;
+  excluded_instance_id_ = RTC_INVALID_GEOMETRY_ID;
+  if (excluded_name) {
+    excluded_instance_id_ = scene.findInstanceId(excluded_name.value())
+                              .value_or(RTC_INVALID_GEOMETRY_ID);
   }
+  chunk_points_.resize(getChunkCount());
+  chunk_detected_ids_.resize(getChunkCount());
+}
 
-  // Run as many threads as physical cores (which is usually /2 virtual threads)
-  // In heavy loads virtual threads (hyper-threading) add little to the overall performance
-  // This also minimizes cost of creating a thread (roughly 10us on Intel/Linux)
-  int thread_count = std::thread::hardware_concurrency() / 2;
-  // Per thread data structures:
-  std::vector<std::thread> threads(thread_count);
-  std::vector<std::set<unsigned int>> thread_detected_ids(thread_count);
-  std::vector<pcl::PointCloud<pcl::PointXYZI>::Ptr> thread_cloud(thread_count);
+std::size_t Raycaster::getChunkCount() const
+{
+  return (directions_x_.size() + rays_per_chunk - 1) / rays_per_chunk;
+}
 
-  rtcCommitScene(scene_);
-  RTCIntersectContext context;
-  for (unsigned int i = 0; i < threads.size(); ++i) {
-    thread_cloud[i] = pcl::PointCloud<pcl::PointXYZI>::Ptr(new pcl::PointCloud<pcl::PointXYZI>());
-    threads[i] = std::thread(
-      intersect, i, thread_count, scene_, thread_cloud[i], context, origin,
-      std::ref(thread_detected_ids[i]), max_distance, min_distance, std::ref(rotation_matrices_));
-  }
-  for (unsigned int i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-    (*cloud) += *(thread_cloud[i]);
-  }
-  for (auto && detected_ids_in_thread : thread_detected_ids) {
-    for (const auto & id : detected_ids_in_thread) {
-      detected_objects_.emplace_back(geometry_ids_[id]);
+void Raycaster::intersect(std::size_t chunk)
+{
+  auto & points = chunk_points_[chunk];
+  auto & detected_ids = chunk_detected_ids_[chunk];
+  points.clear();
+  detected_ids.clear();
+  /// @note The context is modified by Embree while traversing instances, so it is not shared.
+  IntersectContext context;
+  rtcInitIntersectContext(&context.context);
+  context.context.filter = filterExcludedInstance;
+  context.excluded_instance_id = excluded_instance_id_;
+  const auto begin = chunk * rays_per_chunk;
+  const auto end = std::min(begin + rays_per_chunk, directions_x_.size());
+  for (auto packet_begin = begin; packet_begin < end; packet_begin += rays_per_packet) {
+    const auto packet_size = std::min(rays_per_packet, end - packet_begin);
+    /// @note Rays past the end of the last packet are disabled by the valid mask.
+    alignas(64) std::array<int, rays_per_packet> valid;
+    RTCRayHit16 rayhit;
+    for (std::size_t lane = 0; lane < rays_per_packet; ++lane) {
+      const auto i = std::min(packet_begin + lane, end - 1);
+      valid[lane] = lane < packet_size ? -1 : 0;
+      rayhit.ray.org_x[lane] = origin_.position.x;
+      rayhit.ray.org_y[lane] = origin_.position.y;
+      rayhit.ray.org_z[lane] = origin_.position.z;
+      rayhit.ray.dir_x[lane] = orientation_matrix_(0, 0) * directions_x_[i] +
+                               orientation_matrix_(0, 1) * directions_y_[i] +
+                               orientation_matrix_(0, 2) * directions_z_[i];
+      rayhit.ray.dir_y[lane] = orientation_matrix_(1, 0) * directions_x_[i] +
+                               orientation_matrix_(1, 1) * directions_y_[i] +
+                               orientation_matrix_(1, 2) * directions_z_[i];
+      rayhit.ray.dir_z[lane] = orientation_matrix_(2, 0) * directions_x_[i] +
+                               orientation_matrix_(2, 1) * directions_y_[i] +
+                               orientation_matrix_(2, 2) * directions_z_[i];
+      rayhit.ray.tnear[lane] = min_distance_;
+      rayhit.ray.tfar[lane] = max_distance_;
+      rayhit.ray.time[lane] = 0;
+      // make raycast interact with all objects
+      rayhit.ray.mask[lane] = 0b11111111'11111111'11111111'11111111;
+      rayhit.ray.id[lane] = 0;
+      rayhit.ray.flags[lane] = 0;
+      rayhit.hit.geomID[lane] = RTC_INVALID_GEOMETRY_ID;
+      rayhit.hit.instID[0][lane] = RTC_INVALID_GEOMETRY_ID;
+    }
+    if (ray_packets_enabled_) {
+      rtcIntersect16(valid.data(), scene_->getScene(), &context.context, &rayhit);
+    } else {
+      for (std::size_t lane = 0; lane < packet_size; ++lane) {
+        intersectLane(scene_->getScene(), context.context, rayhit, lane);
+      }
     }
-  }
 
-  for (const auto & id : geometry_ids_) {
-    rtcDetachGeometry(scene_, id.first);
+    for (std::size_t lane = 0; lane < packet_size; ++lane) {
+      if (rayhit.hit.geomID[lane] != RTC_INVALID_GEOMETRY_ID) {
+        const auto i = packet_begin + lane;
+        const auto distance = rayhit.ray.tfar[lane];
+        points.push_back(
+          {directions_x_[i] * distance, directions_y_[i] * distance, directions_z_[i] * distance,
+           0.0f});
+        /// @note Consecutive rays mostly hit the same box, so only changes of the box are recorded.
+        if (detected_ids.empty() or detected_ids.back() != rayhit.hit.instID[0][lane]) {
+          detected_ids.push_back(rayhit.hit.instID[0][lane]);
+        }
+      }
+    }
   }
+}
 
-  geometry_ids_.clear();
-  primitive_ptrs_.clear();
-
+sensor_msgs::msg::PointCloud2 Raycaster::finish(
+  const std::string & frame_id, const rclcpp::Time & stamp,
+  traffic_simulator::helper::ThreadPool & thread_pool)
+{
+  const auto chunk_count = getChunkCount();
+  std::vector<std::size_t> offsets(chunk_count + 1, 0);
+  for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+    offsets[chunk + 1] = offsets[chunk] + chunk_points_[chunk].size();
+  }
   sensor_msgs::msg::PointCloud2 pointcloud_msg;
-  pcl::toROSMsg(*cloud, pointcloud_msg);
   pointcloud_msg.header.frame_id = frame_id;
   pointcloud_msg.header.stamp = stamp;
+  pointcloud_msg.height = 1;
+  pointcloud_msg.width = offsets.back();
+  pointcloud_msg.fields = {
+    makePointField("x", offsetof(Point, x)), makePointField("y", offsetof(Point, y)),
+    makePointField("z", offsetof(Point, z)),
+    makePointField("intensity", offsetof(Point, intensity))};
+  pointcloud_msg.is_bigendian = false;
+  pointcloud_msg.point_step = sizeof(Point);
+  pointcloud_msg.row_step = pointcloud_msg.width * pointcloud_msg.point_step;
+  pointcloud_msg.is_dense = true;
+  /// @note The hits are written directly into the data of the message, without a PCL point cloud
+  /// converted afterwards, so each point is copied once.
+  pointcloud_msg.data.resize(pointcloud_msg.row_step);
+  thread_pool.parallelFor(chunk_count, [&](std::size_t chunk) {
+    if (not chunk_points_[chunk].empty()) {
+      std::memcpy(
+        pointcloud_msg.data.data() + offsets[chunk] * sizeof(Point), chunk_points_[chunk].data(),
+        chunk_points_[chunk].size() * sizeof(Point));
+    }
+  });
+
+  std::set<unsigned int> detected_ids;
+  for (const auto & ids : chunk_detected_ids_) {
+    detected_ids.insert(ids.begin(), ids.end());
+  }
+  for (const auto & id : detected_ids) {
+    if (const auto name = scene_->findName(id)) {
+      detected_objects_.emplace_back(name.value());
+    }
+  }
+
   return pointcloud_msg;
 }
 }  // namespace simple_sensor_simulator
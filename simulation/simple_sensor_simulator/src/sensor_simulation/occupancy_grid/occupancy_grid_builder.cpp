@@ -64,7 +64,8 @@ auto OccupancyGridBuilder::makePoint(double x, double y, double z) const -> Poin
   return res;
 }
 
-auto OccupancyGridBuilder::makeOccupiedArea(const PrimitiveType & primitive) const -> PolygonType
+auto OccupancyGridBuilder::makeOccupiedArea(
+  PolygonType::const_iterator first, PolygonType::const_iterator last) const -> PolygonType
 {
   namespace bg = boost::geometry;
   using Point = bg::model::d2::point_xy<double>;
@@ -72,8 +73,8 @@ auto OccupancyGridBuilder::makeOccupiedArea(const PrimitiveType & primitive) con
 
   // Generate a polygon of given primitive
   auto primitive_ring = Ring();
-  for (auto & e : primitive.get2DConvexHull()) {
-    auto p = transformToGrid(e);
+  for (auto it = first; it != last; ++it) {
+    auto p = transformToGrid(*it);
     primitive_ring.emplace_back(p.x, p.y);
   }
 
@@ -254,6 +255,24 @@ auto OccupancyGridBuilder::addPolygon(MarkerGridType & grid, const PolygonType &
 }
 
 auto OccupancyGridBuilder::add(const PrimitiveType & primitive) -> void
+{
+  convex_hulls_.clear();
+  primitive.append2DConvexHull(convex_hulls_);
+  addConvexHull(convex_hulls_.cbegin(), convex_hulls_.cend());
+}
+
+auto OccupancyGridBuilder::add(const std::vector<primitives::Box> & boxes) -> void
+{
+  primitives::get2DConvexHulls(boxes, convex_hulls_, convex_hull_offsets_);
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    addConvexHull(
+      convex_hulls_.cbegin() + convex_hull_offsets_[i],
+      convex_hulls_.cbegin() + convex_hull_offsets_[i + 1]);
+  }
+}
+
+auto OccupancyGridBuilder::addConvexHull(
+  PolygonType::const_iterator first, PolygonType::const_iterator last) -> void
 {
   {
     constexpr auto count_max = std::numeric_limits<MarkerCounterType>::max();
@@ -263,7 +282,7 @@ auto OccupancyGridBuilder::add(const PrimitiveType & primitive) -> void
     }
   }
 
-  auto occupied_area = makeOccupiedArea(primitive);
+  auto occupied_area = makeOccupiedArea(first, last);
 
   auto invisible_area = makeInvisibleArea(occupied_area);
 
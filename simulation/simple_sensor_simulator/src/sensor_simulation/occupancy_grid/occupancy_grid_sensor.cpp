@@ -97,7 +97,7 @@ auto OccupancyGridSensor<nav_msgs::msg::OccupancyGrid>::getOccupancyGrid(
   }
 
   // construct an occupancy grid
-  builder_.reset(ego_pose_north_up);
+  auto boxes = std::vector<primitives::Box>();
   for (const auto & s : status) {
     if (configuration_.entity() != s.name()) {
       // skip if entity is not actually detected
@@ -119,9 +119,11 @@ auto OccupancyGridSensor<nav_msgs::msg::OccupancyGrid>::getOccupancyGrid(
       }
 
       const auto & v = s.bounding_box().dimensions();
-      builder_.add(primitives::Box(v.x(), v.y(), v.z(), pose));
+      boxes.emplace_back(v.x(), v.y(), v.z(), pose);
     }
   }
+  builder_.reset(ego_pose_north_up);
+  builder_.add(boxes);
   builder_.build();
 
   // construct message
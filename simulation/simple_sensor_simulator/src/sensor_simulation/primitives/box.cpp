@@ -108,7 +108,13 @@ Box::Box(float depth, float width, float height, const geometry_msgs::msg::Pose
   triangles_[11].v1 = 5;
   triangles_[11].v2 = 7;
 
-  // transform();
+  // vertices 0, 2, 6, 4 are the bottom face in clockwise order seen from above
+  for (const auto i : {0, 2, 6, 4, 0}) {
+    geometry_msgs::msg::Point p;
+    p.x = vertices_[i].x;
+    p.y = vertices_[i].y;
+    local_2d_convex_hull_.push_back(p);
+  }
 }
 }  // namespace primitives
 }  // namespace simple_sensor_simulator
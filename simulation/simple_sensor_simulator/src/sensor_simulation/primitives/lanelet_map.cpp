@@ -0,0 +1,107 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <simple_sensor_simulator/sensor_simulation/primitives/lanelet_map.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+namespace primitives
+{
+namespace
+{
+/// @note Types of line strings in the lanelet2 format which are extruded, with their height.
+const std::array<std::pair<const char *, double>, 5> wall_heights = {
+  {{"curbstone", 0.15}, {"road_border", 0.15}, {"jersey_barrier", 0.8}, {"fence", 1.5},
+   {"wall", 2.0}}};
+}  // namespace
+
+LaneletMap::LaneletMap(const hdmap_utils::HdMapUtils & hdmap_utils)
+: Primitive("LaneletMap", geometry_msgs::msg::Pose())
+{
+  for (const auto & lanelet_id : hdmap_utils.getLaneletIds()) {
+    appendRoadSurface(hdmap_utils.getLeftBound(lanelet_id), hdmap_utils.getRightBound(lanelet_id));
+  }
+  for (const auto & [type, height] : wall_heights) {
+    for (const auto & line_string : hdmap_utils.getLineStrings(type)) {
+      appendWall(line_string, height);
+    }
+  }
+}
+
+void LaneletMap::appendRoadSurface(
+  const std::vector<geometry_msgs::msg::Point> & left_bound,
+  const std::vector<geometry_msgs::msg::Point> & right_bound)
+{
+  if (left_bound.empty() or right_bound.empty()) {
+    return;
+  }
+  const auto left_offset = static_cast<unsigned int>(vertices_.size());
+  const auto right_offset = static_cast<unsigned int>(left_offset + left_bound.size());
+  for (const auto & point : left_bound) {
+    vertices_.push_back(toVertex(point));
+  }
+  for (const auto & point : right_bound) {
+    vertices_.push_back(toVertex(point));
+  }
+  const auto distance = [](const auto & a, const auto & b) {
+    return std::hypot(a.x - b.x, a.y - b.y, a.z - b.z);
+  };
+  /// @note Walk along both bounds, always advancing on the side giving the shorter diagonal.
+  std::size_t left = 0;
+  std::size_t right = 0;
+  while (left + 1 < left_bound.size() or right + 1 < right_bound.size()) {
+    if (
+      right + 1 == right_bound.size() or
+      (left + 1 < left_bound.size() and
+       distance(left_bound[left + 1], right_bound[right]) <
+         distance(left_bound[left], right_bound[right + 1]))) {
+      triangles_.push_back(Triangle{
+        static_cast<unsigned int>(left_offset + left),
+        static_cast<unsigned int>(right_offset + right),
+        static_cast<unsigned int>(left_offset + left + 1)});
+      ++left;
+    } else {
+      triangles_.push_back(Triangle{
+        static_cast<unsigned int>(left_offset + left),
+        static_cast<unsigned int>(right_offset + right),
+        static_cast<unsigned int>(right_offset + right + 1)});
+      ++right;
+    }
+  }
+}
+
+void LaneletMap::appendWall(
+  const std::vector<geometry_msgs::msg::Point> & line_string, double height)
+{
+  const auto offset = static_cast<unsigned int>(vertices_.size());
+  for (const auto & point : line_string) {
+    auto top = point;
+    top.z += height;
+    vertices_.push_back(toVertex(point));
+    vertices_.push_back(toVertex(top));
+  }
+  for (unsigned int i = 0; i + 1 < line_string.size(); ++i) {
+    const auto bottom = offset + 2 * i;
+    triangles_.push_back(Triangle{bottom, bottom + 2, bottom + 1});
+    triangles_.push_back(Triangle{bottom + 2, bottom + 3, bottom + 1});
+  }
+}
+}  // namespace primitives
+}  // namespace simple_sensor_simulator
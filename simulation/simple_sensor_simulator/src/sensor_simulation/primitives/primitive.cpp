@@ -15,6 +15,7 @@
 #include <quaternion_operation/quaternion_operation.h>
 
 #include <algorithm>
+#include <cmath>
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <boost/geometry/geometries/polygon.hpp>
@@ -103,15 +104,66 @@ std::vector<Vertex> Primitive::getVertex() const { return transform(); }
 
 std::vector<Triangle> Primitive::getTriangles() const { return triangles_; }
 
+std::size_t Primitive::getTriangleCount() const { return triangles_.size(); }
+
+void Primitive::append2DConvexHull(
+  const geometry_msgs::msg::Quaternion & rotation, const geometry_msgs::msg::Point & translation,
+  std::vector<geometry_msgs::msg::Point> & hull) const
+{
+  constexpr double tolerance = 1e-6;
+  if (
+    local_2d_convex_hull_.empty() or std::abs(rotation.x) > tolerance or
+    std::abs(rotation.y) > tolerance) {
+    /**
+     * @note With roll or pitch rotation, the projection of the rotated primitive onto the xy plane
+     *       is not a rigid transform of the convex hull in local frame.
+     */
+    geometry_msgs::msg::Pose pose;
+    pose.orientation = rotation;
+    pose.position = translation;
+    std::vector<geometry_msgs::msg::Point> points;
+    points.reserve(vertices_.size());
+    for (const auto & v : vertices_) {
+      points.emplace_back(math::geometry::transformPoint(pose, toPoint(v)));
+    }
+    const auto convex_hull = math::geometry::get2DConvexHull(points);
+    hull.insert(hull.end(), convex_hull.begin(), convex_hull.end());
+  } else {
+    const double cos_yaw = 1.0 - 2.0 * rotation.z * rotation.z;
+    const double sin_yaw = 2.0 * rotation.z * rotation.w;
+    for (const auto & p : local_2d_convex_hull_) {
+      geometry_msgs::msg::Point transformed;
+      transformed.x = cos_yaw * p.x - sin_yaw * p.y + translation.x;
+      transformed.y = sin_yaw * p.x + cos_yaw * p.y + translation.y;
+      hull.push_back(transformed);
+    }
+  }
+}
+
+void Primitive::append2DConvexHull(std::vector<geometry_msgs::msg::Point> & hull) const
+{
+  append2DConvexHull(pose.orientation, pose.position, hull);
+}
+
 std::vector<geometry_msgs::msg::Point> Primitive::get2DConvexHull(
   const geometry_msgs::msg::Pose & sensor_pose) const
 {
-  return math::geometry::get2DConvexHull(toPoints(transform(sensor_pose)));
+  geometry_msgs::msg::Point translation;
+  translation.x = pose.position.x - sensor_pose.position.x;
+  translation.y = pose.position.y - sensor_pose.position.y;
+  translation.z = pose.position.z - sensor_pose.position.z;
+  std::vector<geometry_msgs::msg::Point> hull;
+  append2DConvexHull(
+    quaternion_operation::getRotation(sensor_pose.orientation, pose.orientation), translation,
+    hull);
+  return hull;
 }
 
 std::vector<geometry_msgs::msg::Point> Primitive::get2DConvexHull() const
 {
-  return math::geometry::get2DConvexHull(toPoints(transform()));
+  std::vector<geometry_msgs::msg::Point> hull;
+  append2DConvexHull(hull);
+  return hull;
 }
 
 unsigned int Primitive::addToScene(RTCDevice device, RTCScene scene)
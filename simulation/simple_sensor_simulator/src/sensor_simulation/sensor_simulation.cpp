@@ -12,9 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <simple_sensor_simulator/sensor_simulation/sensor_simulation.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
@@ -25,8 +28,27 @@ void SensorSimulation::updateSensorFrame(
   const std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> & traffic_signals)
 {
   std::vector<std::string> lidar_detected_objects = {};
+  /// @note The scene is only updated in frames where at least one lidar scans.
+  if (std::any_of(lidar_sensors_.begin(), lidar_sensors_.end(), [&](const auto & sensor) {
+        return sensor->isScanDue(current_time);
+      })) {
+    lidar_scene_.update(status);
+  }
+  /// @note The chunks of the scans of all lidars are traced in one parallel loop, so lidars
+  /// scanning in the same frame are traced concurrently against the same scene.
+  std::vector<std::pair<Raycaster *, std::size_t>> chunks;
+  for (auto & sensor : lidar_sensors_) {
+    if (sensor->prepareScan(current_time, status, lidar_scene_)) {
+      auto & raycaster = sensor->getRaycaster();
+      for (std::size_t chunk = 0; chunk < raycaster.getChunkCount(); ++chunk) {
+        chunks.emplace_back(&raycaster, chunk);
+      }
+    }
+  }
+  raycast_thread_pool_->parallelFor(
+    chunks.size(), [&](std::size_t i) { chunks[i].first->intersect(chunks[i].second); });
   for (auto & sensor : lidar_sensors_) {
-    sensor->update(current_time, status, current_ros_time);
+    sensor->update(current_time, current_ros_time);
     const auto objects = sensor->getDetectedObjects();
     for (const auto & obj : objects) {
       if (std::count(lidar_detected_objects.begin(), lidar_detected_objects.end(), obj) == 0) {
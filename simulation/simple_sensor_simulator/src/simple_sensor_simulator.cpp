@@ -15,6 +15,7 @@
 #include <quaternion_operation/quaternion_operation.h>
 
 #include <algorithm>
+#include <chrono>
 #include <geometry_msgs/msg/pose_stamped.hpp>
 #include <limits>
 #include <memory>
@@ -34,6 +35,7 @@ ScenarioSimulator::ScenarioSimulator(const rclcpp::NodeOptions & options)
   sensor_sim_(*this),
   server_(
     simulation_interface::protocol, simulation_interface::HostName::ANY, getSocketPort(),
+    getServerOptions(),
     [this](auto &&... xs) { return initialize(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return updateFrame(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return spawnVehicleEntity(std::forward<decltype(xs)>(xs)...); },
@@ -45,8 +47,21 @@ ScenarioSimulator::ScenarioSimulator(const rclcpp::NodeOptions & options)
     [this](auto &&... xs) { return attachDetectionSensor(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return attachOccupancyGridSensor(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return updateTrafficLights(std::forward<decltype(xs)>(xs)...); },
-    [this](auto &&... xs) { return followPolylineTrajectory(std::forward<decltype(xs)>(xs)...); })
+    [this](auto &&... xs) { return followPolylineTrajectory(std::forward<decltype(xs)>(xs)...); },
+    [this](auto &&... xs) { return updateEntityStatusBatch(std::forward<decltype(xs)>(xs)...); },
+    [this](auto &&... xs) { return step(std::forward<decltype(xs)>(xs)...); })
 {
+  if (get_parameter("record_rpc_statistics").as_bool()) {
+    diagnostics_pub_ =
+      create_publisher<diagnostic_msgs::msg::DiagnosticArray>("/diagnostics", rclcpp::QoS(10));
+    diagnostics_timer_ = create_wall_timer(std::chrono::seconds(1), [this]() {
+      diagnostic_msgs::msg::DiagnosticArray diagnostics;
+      diagnostics.header.stamp = now();
+      diagnostics.status = simulation_interface::toDiagnosticStatuses(
+        "simple_sensor_simulator", server_.getStatistics());
+      diagnostics_pub_->publish(diagnostics);
+    });
+  }
 }
 
 geographic_msgs::msg::GeoPoint ScenarioSimulator::getOrigin()
@@ -66,7 +81,17 @@ geographic_msgs::msg::GeoPoint ScenarioSimulator::getOrigin()
   return origin;
 }
 
-ScenarioSimulator::~ScenarioSimulator() {}
+ScenarioSimulator::~ScenarioSimulator()
+{
+  if (const auto path = get_parameter("rpc_statistics_file").as_string();
+      get_parameter("record_rpc_statistics").as_bool() and not path.empty()) {
+    try {
+      simulation_interface::writeJson(path, server_.getStatistics());
+    } catch (const common::SimulationError & error) {
+      RCLCPP_ERROR_STREAM(get_logger(), error.what());
+    }
+  }
+}
 
 int ScenarioSimulator::getSocketPort()
 {
@@ -74,6 +99,15 @@ int ScenarioSimulator::getSocketPort()
   return get_parameter("port").as_int();
 }
 
+auto ScenarioSimulator::getServerOptions() -> zeromq::MultiServer::Options
+{
+  if (!has_parameter("record_rpc_statistics")) declare_parameter("record_rpc_statistics", false);
+  if (!has_parameter("rpc_statistics_file")) declare_parameter("rpc_statistics_file", "");
+  auto options = zeromq::MultiServer::Options();
+  options.record_statistics = get_parameter("record_rpc_statistics").as_bool();
+  return options;
+}
+
 auto ScenarioSimulator::initialize(const simulation_api_schema::InitializeRequest & req)
   -> simulation_api_schema::InitializeResponse
 {
@@ -81,6 +115,16 @@ auto ScenarioSimulator::initialize(const simulation_api_schema::InitializeReques
   realtime_factor_ = req.realtime_factor();
   step_time_ = req.step_time();
   hdmap_utils_ = std::make_shared<hdmap_utils::HdMapUtils>(req.lanelet2_map_path(), getOrigin());
+  /**
+   * @note Lidars publish the obstacle point cloud, from which the ground is already removed, so
+   * road surfaces and curbs are only seen by lidars if explicitly enabled.
+   */
+  if (!has_parameter("lidar_map_geometry")) declare_parameter("lidar_map_geometry", false);
+  if (get_parameter("lidar_map_geometry").as_bool()) {
+    sensor_sim_.setLidarMap(*hdmap_utils_);
+  } else {
+    sensor_sim_.clearLidarMap();
+  }
   auto res = simulation_api_schema::InitializeResponse();
   res.mutable_result()->set_success(true);
   res.mutable_result()->set_description("succeed to initialize simulation");
@@ -89,6 +133,7 @@ auto ScenarioSimulator::initialize(const simulation_api_schema::InitializeReques
   pedestrians_ = {};
   misc_objects_ = {};
   entity_status_ = {};
+  entity_status_indices_ = {};
   return res;
 }
 
@@ -105,21 +150,8 @@ auto ScenarioSimulator::updateFrame(const simulation_api_schema::UpdateFrameRequ
   builtin_interfaces::msg::Time t;
   simulation_interface::toMsg(req.current_ros_time(), t);
   current_ros_time_ = t;
-  std::vector<traffic_simulator_msgs::EntityStatus> entity_status;
-  std::transform(
-    entity_status_.begin(), entity_status_.end(), std::back_inserter(entity_status),
-    [this](const auto & map_element) {
-      traffic_simulator_msgs::EntityStatus status;
-      *status.mutable_pose() = map_element.second.pose();
-      *status.mutable_action_status() = map_element.second.action_status();
-      *status.mutable_name() = map_element.second.name();
-      *status.mutable_type() = map_element.second.type();
-      *status.mutable_subtype() = map_element.second.subtype();
-      *status.mutable_bounding_box() = getBoundingBox(status.name());
-      return status;
-    });
   sensor_sim_.updateSensorFrame(
-    current_time_, current_ros_time_, entity_status, traffic_signals_states_);
+    current_time_, current_ros_time_, entity_status_, traffic_signals_states_);
   res.mutable_result()->set_success(true);
   res.mutable_result()->set_description("succeed to update frame");
   return res;
@@ -129,28 +161,81 @@ auto ScenarioSimulator::updateEntityStatus(
   const simulation_api_schema::UpdateEntityStatusRequest & req)
   -> simulation_api_schema::UpdateEntityStatusResponse
 {
-  if (isEgo(req.status().name())) {
-    if (ego_entity_simulation_) {
-      ego_entity_simulation_->update(
-        current_time_ + step_time_, step_time_, req.npc_logic_started());
+  auto res = simulation_api_schema::UpdateEntityStatusResponse();
+  updateEntityStatus(req.status(), req.npc_logic_started(), *res.mutable_status());
+  res.mutable_result()->set_success(true);
+  res.mutable_result()->set_description("");
+  return res;
+}
+
+auto ScenarioSimulator::updateEntityStatusBatch(
+  const simulation_api_schema::UpdateEntityStatusBatchRequest & req)
+  -> simulation_api_schema::UpdateEntityStatusBatchResponse
+{
+  auto res = simulation_api_schema::UpdateEntityStatusBatchResponse();
+  const auto update = [&](const auto & statuses) {
+    if (req.omit_updated_status()) {
+      auto updated_status = simulation_api_schema::UpdatedEntityStatus();
+      for (const auto & status : statuses) {
+        updateEntityStatus(status, req.npc_logic_started(), updated_status);
+      }
+    } else {
+      res.mutable_status()->Reserve(static_cast<int>(statuses.size()));
+      for (const auto & status : statuses) {
+        updateEntityStatus(status, req.npc_logic_started(), *res.add_status());
+      }
     }
-    simulation_api_schema::EntityStatus status;
-    simulation_interface::toProto(ego_entity_simulation_->getStatus(), status);
-    entity_status_[req.status().name()] = status;
+  };
+  if (req.has_delta()) {
+    update(entity_status_decoder_.decode(req.delta()));
   } else {
-    entity_status_[req.status().name()] = req.status();
+    update(req.status());
   }
-  const simulation_api_schema::EntityStatus & updated_entity_status =
-    entity_status_[req.status().name()];
-  auto res = simulation_api_schema::UpdateEntityStatusResponse();
-  res.mutable_status()->set_name(updated_entity_status.name());
-  res.mutable_status()->mutable_action_status()->CopyFrom(updated_entity_status.action_status());
-  res.mutable_status()->mutable_pose()->CopyFrom(updated_entity_status.pose());
   res.mutable_result()->set_success(true);
   res.mutable_result()->set_description("");
   return res;
 }
 
+auto ScenarioSimulator::step(const simulation_api_schema::StepRequest & req)
+  -> simulation_api_schema::StepResponse
+{
+  auto res = simulation_api_schema::StepResponse();
+  *res.mutable_entity_status() = updateEntityStatusBatch(req.entity_status());
+  if (req.has_traffic_lights()) {
+    updateTrafficLights(req.traffic_lights());
+  }
+  *res.mutable_result() = updateFrame(req.frame()).result();
+  /// @note Same as the UpdateEntityStatusRequest for the ego entity at the start of the next frame.
+  if (res.result().success() and ego_entity_simulation_ and not ego_vehicles_.empty()) {
+    auto ego_status = simulation_api_schema::EntityStatus();
+    ego_status.set_name(ego_vehicles_.front().name());
+    updateEntityStatus(
+      ego_status, req.entity_status().npc_logic_started(), *res.mutable_ego_status());
+  }
+  return res;
+}
+
+auto ScenarioSimulator::updateEntityStatus(
+  const simulation_api_schema::EntityStatus & status, bool npc_logic_started,
+  simulation_api_schema::UpdatedEntityStatus & updated_status) -> void
+{
+  if (isEgo(status.name())) {
+    if (ego_entity_simulation_) {
+      ego_entity_simulation_->update(current_time_ + step_time_, step_time_, npc_logic_started);
+    }
+    simulation_api_schema::EntityStatus ego_status;
+    simulation_interface::toProto(ego_entity_simulation_->getStatus(), ego_status);
+    setEntityStatus(ego_status);
+  } else {
+    setEntityStatus(status);
+  }
+  const traffic_simulator_msgs::EntityStatus & updated_entity_status =
+    entity_status_[entity_status_indices_.at(status.name())];
+  updated_status.set_name(updated_entity_status.name());
+  updated_status.mutable_action_status()->CopyFrom(updated_entity_status.action_status());
+  updated_status.mutable_pose()->CopyFrom(updated_entity_status.pose());
+}
+
 auto ScenarioSimulator::spawnVehicleEntity(
   const simulation_api_schema::SpawnVehicleEntityRequest & req)
   -> simulation_api_schema::SpawnVehicleEntityResponse
@@ -223,7 +308,17 @@ auto ScenarioSimulator::despawnEntity(const simulation_api_schema::DespawnEntity
                                       remove_despawn_requested_entity_from(pedestrians_) or
                                       remove_despawn_requested_entity_from(misc_objects_);
   if (any_entity_was_removed) {
-    entity_status_.erase(req.name());
+    if (const auto iter = entity_status_indices_.find(req.name());
+        iter != entity_status_indices_.end()) {
+      const auto index = iter->second;
+      entity_status_.erase(entity_status_.begin() + index);
+      entity_status_indices_.erase(iter);
+      for (auto && [name, each_index] : entity_status_indices_) {
+        if (each_index > index) {
+          --each_index;
+        }
+      }
+    }
   }
   auto res = simulation_api_schema::DespawnEntityResponse();
   res.mutable_result()->set_success(any_entity_was_removed);
@@ -285,6 +380,22 @@ auto ScenarioSimulator::followPolylineTrajectory(
   return response;
 }
 
+auto ScenarioSimulator::setEntityStatus(const simulation_api_schema::EntityStatus & status) -> void
+{
+  auto [iter, inserted] = entity_status_indices_.emplace(status.name(), entity_status_.size());
+  if (inserted) {
+    /// @note The bounding box does not change after spawning, so it is looked up only once.
+    auto & entity_status = entity_status_.emplace_back();
+    *entity_status.mutable_name() = status.name();
+    *entity_status.mutable_bounding_box() = getBoundingBox(status.name());
+  }
+  auto & entity_status = entity_status_[iter->second];
+  *entity_status.mutable_pose() = status.pose();
+  *entity_status.mutable_action_status() = status.action_status();
+  *entity_status.mutable_type() = status.type();
+  *entity_status.mutable_subtype() = status.subtype();
+}
+
 traffic_simulator_msgs::BoundingBox ScenarioSimulator::getBoundingBox(const std::string & name)
 {
   for (const auto & ego : ego_vehicles_) {
@@ -0,0 +1,145 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <simple_sensor_simulator/sensor_simulation/lidar/lidar_scene.hpp>
+#include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
+#include <string>
+#include <traffic_simulator/helper/thread_pool.hpp>
+#include <vector>
+
+/// @note Horizontal resolution of a Velodyne lidar rotating at 10 Hz.
+constexpr double horizontal_resolution = 0.2 / 180.0 * M_PI;
+
+auto makeLidarConfiguration(double min_vertical_angle, double max_vertical_angle, int channels)
+  -> simulation_api_schema::LidarConfiguration
+{
+  simulation_api_schema::LidarConfiguration configuration;
+  configuration.set_horizontal_resolution(horizontal_resolution);
+  configuration.set_entity("ego");
+  for (int channel = 0; channel < channels; ++channel) {
+    configuration.add_vertical_angles(
+      (min_vertical_angle + (max_vertical_angle - min_vertical_angle) * channel / (channels - 1)) /
+      180.0 * M_PI);
+  }
+  return configuration;
+}
+
+/**
+ * @brief Boxes of vehicles on rings around the ego entity at the origin, and the box of the ego
+ * entity itself, which the raycaster must ignore.
+ */
+auto makeLidarScene(simple_sensor_simulator::LidarScene & scene) -> void
+{
+  geometry_msgs::msg::Pose pose;
+  pose.position.z = 1.0;
+  scene.updateBox("ego", 4.5, 2.0, 2.0, pose);
+  for (int ring = 1; ring <= 8; ++ring) {
+    for (int i = 0; i < 12; ++i) {
+      const auto angle = (i + 0.5 * ring) / 12.0 * 2 * M_PI;
+      pose.position.x = 7.5 * ring * std::cos(angle);
+      pose.position.y = 7.5 * ring * std::sin(angle);
+      pose.orientation.z = std::sin(angle * 0.5);
+      pose.orientation.w = std::cos(angle * 0.5);
+      scene.updateBox("npc" + std::to_string(ring * 12 + i), 4.5, 2.0, 1.5, pose);
+    }
+  }
+  scene.commit();
+}
+
+struct Scan
+{
+  sensor_msgs::msg::PointCloud2 pointcloud;
+  std::vector<std::string> detected_objects;
+  double rays_per_second;
+};
+
+auto scan(
+  simple_sensor_simulator::Raycaster & raycaster, const simple_sensor_simulator::LidarScene & scene,
+  std::size_t ray_count, bool ray_packets_enabled) -> Scan
+{
+  /// @note Without worker threads, so that only the tracing of the rays is compared.
+  traffic_simulator::helper::ThreadPool thread_pool(0);
+  raycaster.setRayPacketsEnabled(ray_packets_enabled);
+  geometry_msgs::msg::Pose origin;
+  origin.position.z = 2.5;
+  constexpr int repetitions = 10;
+  Scan result;
+  const auto begin = std::chrono::steady_clock::now();
+  for (int repetition = 0; repetition < repetitions; ++repetition) {
+    raycaster.prepare(scene, origin, "ego");
+    for (std::size_t chunk = 0; chunk < raycaster.getChunkCount(); ++chunk) {
+      raycaster.intersect(chunk);
+    }
+    result.pointcloud = raycaster.finish("base_link", rclcpp::Time(), thread_pool);
+  }
+  const auto seconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  result.detected_objects = raycaster.getDetectedObject();
+  result.rays_per_second = ray_count * repetitions / seconds;
+  return result;
+}
+
+auto compareRayPackets(const std::string & name, double min_angle, double max_angle, int channels)
+  -> void
+{
+  simple_sensor_simulator::LidarScene scene;
+  makeLidarScene(scene);
+  simple_sensor_simulator::Raycaster raycaster;
+  raycaster.setDirection(makeLidarConfiguration(min_angle, max_angle, channels));
+  /// @note Raycaster::setDirection casts one column of rays per step in [0, 2 * M_PI].
+  const auto ray_count =
+    static_cast<std::size_t>(std::floor(2 * M_PI / horizontal_resolution) + 1) * channels;
+
+  const auto single = scan(raycaster, scene, ray_count, false);
+  const auto packet = scan(raycaster, scene, ray_count, true);
+  std::cout << name << ": rtcIntersect1 " << single.rays_per_second << " rays/s, rtcIntersect16 "
+            << packet.rays_per_second << " rays/s" << std::endl;
+  testing::Test::RecordProperty(
+    name + "_rtcIntersect1_rays_per_second", std::to_string(single.rays_per_second));
+  testing::Test::RecordProperty(
+    name + "_rtcIntersect16_rays_per_second", std::to_string(packet.rays_per_second));
+
+  EXPECT_GT(single.pointcloud.width, 0u);
+  EXPECT_EQ(single.pointcloud.width, packet.pointcloud.width);
+  EXPECT_EQ(single.detected_objects, packet.detected_objects);
+  EXPECT_FALSE(single.detected_objects.empty());
+  EXPECT_EQ(
+    std::count(single.detected_objects.begin(), single.detected_objects.end(), "ego"), 0);
+  ASSERT_EQ(single.pointcloud.data.size(), packet.pointcloud.data.size());
+  const auto count = single.pointcloud.data.size() / sizeof(float);
+  std::vector<float> single_points(count);
+  std::vector<float> packet_points(count);
+  std::memcpy(single_points.data(), single.pointcloud.data.data(), count * sizeof(float));
+  std::memcpy(packet_points.data(), packet.pointcloud.data.data(), count * sizeof(float));
+  for (std::size_t i = 0; i < count; ++i) {
+    EXPECT_NEAR(single_points[i], packet_points[i], 1e-4) << "at " << i;
+  }
+}
+
+TEST(Raycaster, RayPacketsVLP16) { compareRayPackets("VLP16", -15.0, 15.0, 16); }
+
+TEST(Raycaster, RayPackets128Channels) { compareRayPackets("128_channels", -25.0, 15.0, 128); }
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -19,7 +19,11 @@
 
 namespace simulation_interface
 {
-enum class TransportProtocol { TCP /*, UDP*/ };
+/**
+ * @note SHARED_MEMORY passes request and response bodies through a shared memory segment and only
+ * signals them over TCP. Clients fall back to TCP when the server is not on localhost.
+ */
+enum class TransportProtocol { TCP, SHARED_MEMORY /*, UDP*/ };
 
 std::string enumToString(const TransportProtocol & protocol);
 
@@ -34,6 +38,8 @@ std::string getEndPoint(
 
 std::string getEndPoint(
   const TransportProtocol & protocol, const std::string & hostname, const unsigned int & port);
+
+bool isLocalHost(const std::string & hostname);
 }  // namespace simulation_interface
 
 #endif  // SIMULATION_INTERFACE__CONSTANTS_HPP_
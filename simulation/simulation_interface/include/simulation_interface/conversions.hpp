@@ -27,6 +27,8 @@
 #include <autoware_auto_vehicle_msgs/msg/gear_command.hpp>
 #include <builtin_interfaces/msg/duration.hpp>
 #include <builtin_interfaces/msg/time.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <geometry_msgs/msg/accel.hpp>
 #include <geometry_msgs/msg/point.hpp>
 #include <geometry_msgs/msg/pose.hpp>
@@ -34,6 +36,7 @@
 #include <geometry_msgs/msg/twist.hpp>
 #include <geometry_msgs/msg/vector3.hpp>
 #include <iostream>
+#include <memory>
 #include <rosgraph_msgs/msg/clock.hpp>
 #include <simulation_interface/constants.hpp>
 #include <std_msgs/msg/header.hpp>
@@ -55,22 +58,43 @@
 
 namespace zeromq
 {
+/**
+ * @brief Serialize proto directly into a new frame appended to msg.
+ * @note The frame takes ownership of the serialized buffer, so the bytes are not copied again.
+ */
+template <typename Proto>
+void addFrame(zmqpp::message & msg, const Proto & proto)
+{
+  const auto size = proto.ByteSizeLong();
+  auto buffer = std::unique_ptr<std::uint8_t[]>(new std::uint8_t[size]);
+  proto.SerializeWithCachedSizesToArray(buffer.get());
+  msg.add_nocopy(buffer.release(), size, [](void * data, void *) {
+    delete[] static_cast<std::uint8_t *>(data);
+  });
+}
+
+/**
+ * @brief Parse proto directly from the raw data of a frame of msg.
+ */
+template <typename Proto>
+bool parseFrame(const zmqpp::message & msg, std::size_t part, Proto & proto)
+{
+  return proto.ParseFromArray(msg.raw_data(part), static_cast<int>(msg.size(part)));
+}
+
 template <typename Proto>
 zmqpp::message toZMQ(const Proto & proto)
 {
   zmqpp::message msg;
-  std::string serialized_str = "";
-  proto.SerializeToString(&serialized_str);
-  msg << serialized_str;
+  addFrame(msg, proto);
   return msg;
 }
 
 template <typename Proto>
 Proto toProto(const zmqpp::message & msg)
 {
-  std::string serialized_str = msg.get(0);
   Proto proto;
-  proto.ParseFromString(serialized_str);
+  parseFrame(msg, 0, proto);
   return proto;
 }
 }  // namespace zeromq
@@ -0,0 +1,79 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMULATION_INTERFACE__ENTITY_STATUS_DELTA_HPP_
+#define SIMULATION_INTERFACE__ENTITY_STATUS_DELTA_HPP_
+
+#include <simulation_api_schema.pb.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace simulation_interface
+{
+/**
+ * @brief Encoder of the entity statuses of each frame as an EntityStatusDeltaFrame.
+ * @note The name, type and subtype of an entity are sent once, when its compact id is declared, and
+ * afterwards only the fields that changed since the previous frame are sent. Every
+ * keyframe_interval frames a keyframe with all fields is sent, so that a decoder can resynchronise.
+ * The frames must be decoded in the order they are encoded, each exactly once.
+ */
+class EntityStatusDeltaEncoder
+{
+public:
+  explicit EntityStatusDeltaEncoder(std::size_t keyframe_interval = 100);
+
+  auto encode(const std::vector<simulation_api_schema::EntityStatus> & statuses, double time)
+    -> simulation_api_schema::EntityStatusDeltaFrame;
+
+private:
+  struct Entry
+  {
+    std::uint32_t id;
+
+    simulation_api_schema::EntityStatus status;
+
+    std::size_t last_frame;
+  };
+
+  const std::size_t keyframe_interval_;
+
+  std::size_t frame_count_ = 0;
+
+  std::uint32_t next_id_ = 0;
+
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+/**
+ * @brief Decoder of the EntityStatusDeltaFrames encoded by an EntityStatusDeltaEncoder.
+ */
+class EntityStatusDeltaDecoder
+{
+public:
+  /**
+   * @brief Statuses of the entities of the frame, in the order of the frame.
+   */
+  auto decode(const simulation_api_schema::EntityStatusDeltaFrame & frame)
+    -> std::vector<simulation_api_schema::EntityStatus>;
+
+private:
+  std::unordered_map<std::uint32_t, simulation_api_schema::EntityStatus> statuses_;
+};
+}  // namespace simulation_interface
+
+#endif  // SIMULATION_INTERFACE__ENTITY_STATUS_DELTA_HPP_
@@ -0,0 +1,161 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMULATION_INTERFACE__RPC_STATISTICS_HPP_
+#define SIMULATION_INTERFACE__RPC_STATISTICS_HPP_
+
+#include <simulation_api_schema.pb.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+#include <map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace simulation_interface
+{
+/**
+ * @brief Histogram of durations with a bounded relative error, in the manner of HdrHistogram.
+ * @note Each power of two of nanoseconds is split into 2^sub_bucket_bits linear buckets, so that
+ * recording is a few integer operations on a fixed array and percentiles are within 1/32 of the
+ * recorded durations at any scale.
+ */
+class LatencyHistogram
+{
+public:
+  auto record(std::chrono::nanoseconds) -> void;
+
+  auto getCount() const noexcept -> std::uint64_t { return count_; }
+
+  auto getMax() const noexcept -> std::chrono::nanoseconds { return max_; }
+
+  auto getMean() const -> std::chrono::nanoseconds;
+
+  /**
+   * @brief Smallest duration which is not less than the given fraction of the recorded durations.
+   * @param quantile fraction in [0, 1], e.g. 0.99 for the 99th percentile.
+   */
+  auto getPercentile(double quantile) const -> std::chrono::nanoseconds;
+
+  static constexpr std::size_t sub_bucket_bits = 5;
+
+private:
+  static auto getBucketIndex(std::uint64_t value) -> std::size_t;
+
+  static auto getBucketUpperBound(std::size_t index) -> std::uint64_t;
+
+  std::array<std::uint64_t, (65 - sub_bucket_bits) << sub_bucket_bits> counts_{};
+
+  std::uint64_t count_ = 0;
+
+  std::chrono::nanoseconds total_ = std::chrono::nanoseconds(0);
+
+  std::chrono::nanoseconds max_ = std::chrono::nanoseconds(0);
+};
+
+/**
+ * @brief Measurements of one request, taken by either the client or the server.
+ * @note Phases which the measuring side does not see are left empty.
+ */
+struct RpcSample
+{
+  /// @note Serialization of the request (client) or the response (server).
+  std::optional<std::chrono::nanoseconds> serialize;
+
+  /// @note Time spent in sending the request (client) or the response (server) to the socket.
+  std::optional<std::chrono::nanoseconds> send;
+
+  /// @note Time from sending the request to receiving its response (client), or time the request
+  /// waits for a worker after it is parsed (server).
+  std::optional<std::chrono::nanoseconds> wait;
+
+  /// @note Execution of the handler of the request (server).
+  std::optional<std::chrono::nanoseconds> handle;
+
+  /// @note Parsing of the response (client) or the request (server).
+  std::optional<std::chrono::nanoseconds> parse;
+
+  std::size_t request_bytes = 0;
+
+  std::size_t response_bytes = 0;
+};
+
+struct RpcStatistics
+{
+  std::uint64_t count = 0;
+
+  std::uint64_t request_bytes = 0;
+
+  std::uint64_t response_bytes = 0;
+
+  LatencyHistogram serialize;
+
+  LatencyHistogram send;
+
+  LatencyHistogram wait;
+
+  LatencyHistogram handle;
+
+  LatencyHistogram parse;
+
+  auto add(const RpcSample &) -> void;
+};
+
+/**
+ * @brief Thread-safe collection of RpcStatistics by request type.
+ */
+class RpcStatisticsRecorder
+{
+public:
+  using RequestCase = simulation_api_schema::SimulationRequest::RequestCase;
+
+  auto record(RequestCase, const RpcSample &) -> void;
+
+  /**
+   * @brief Statistics keyed by the name of the request field in SimulationRequest.
+   */
+  auto getStatistics() const -> std::map<std::string, RpcStatistics>;
+
+private:
+  mutable std::mutex mutex_;
+
+  std::map<RequestCase, RpcStatistics> statistics_;
+};
+
+/**
+ * @brief Summary of each request type: counts, byte counts, and the count, mean, 50th, 90th and
+ * 99th percentiles and maximum of each phase in nanoseconds.
+ */
+auto toJson(const std::map<std::string, RpcStatistics> &) -> nlohmann::json;
+
+/**
+ * @brief Same summary as toJson in milliseconds, as one DiagnosticStatus per request type.
+ */
+auto toDiagnosticStatuses(
+  const std::string & name, const std::map<std::string, RpcStatistics> &)
+  -> std::vector<diagnostic_msgs::msg::DiagnosticStatus>;
+
+/**
+ * @brief Write toJson to the file, throwing common::SimulationError if it cannot be written.
+ */
+auto writeJson(const std::string & path, const std::map<std::string, RpcStatistics> &) -> void;
+}  // namespace simulation_interface
+
+#endif  // SIMULATION_INTERFACE__RPC_STATISTICS_HPP_
@@ -0,0 +1,124 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMULATION_INTERFACE__SHARED_MEMORY_HPP_
+#define SIMULATION_INTERFACE__SHARED_MEMORY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace simulation_interface
+{
+/**
+ * @brief POSIX shared memory segment holding the request and response bodies of in-flight requests.
+ * @note The segment has slot_count request slots and as many response slots, each of slot_size
+ * bytes. The client creates the segment and unlinks it on destruction, and the server opens it by
+ * name when the client asks it to with a SharedMemoryFrameType::OPEN frame. Each in-flight request
+ * takes a free slot, which the client releases once the response is parsed, and its response is
+ * written to the response slot of the same index. Accesses are ordered by the ZeroMQ messages that
+ * announce them.
+ */
+class SharedMemorySegment
+{
+public:
+  /**
+   * @brief Create a new segment.
+   */
+  explicit SharedMemorySegment(
+    const std::string & name, std::size_t slot_count, std::size_t slot_size);
+
+  /**
+   * @brief Open a segment created by another process.
+   */
+  explicit SharedMemorySegment(const std::string & name);
+
+  ~SharedMemorySegment();
+
+  SharedMemorySegment(const SharedMemorySegment &) = delete;
+
+  SharedMemorySegment & operator=(const SharedMemorySegment &) = delete;
+
+  auto getName() const noexcept -> const std::string & { return name_; }
+
+  auto getSlotCount() const noexcept -> std::size_t { return slot_count_; }
+
+  auto getSlotSize() const noexcept -> std::size_t { return slot_size_; }
+
+  auto getRequestSlot(std::size_t slot) const -> std::uint8_t *;
+
+  auto getResponseSlot(std::size_t slot) const -> std::uint8_t *;
+
+private:
+  struct Header
+  {
+    std::uint64_t slot_count;
+    std::uint64_t slot_size;
+  };
+
+  auto map(int file_descriptor) -> void;
+
+  const std::string name_;
+
+  const bool is_owner_;
+
+  std::size_t slot_count_ = 0;
+
+  std::size_t slot_size_ = 0;
+
+  std::size_t size_ = 0;
+
+  std::uint8_t * data_ = nullptr;
+};
+
+enum class SharedMemoryFrameType : std::uint8_t {
+  /// @note The body of the message is in the slot of the frame.
+  BODY,
+  /// @note Asks the server to open the segment, before any BODY frame refers to it.
+  OPEN,
+  /// @note Answers OPEN, telling that the server opened the segment.
+  OPENED,
+  /// @note Answers OPEN, telling that the server cannot open the segment, so bodies should be sent
+  /// in the messages themselves.
+  OPEN_FAILED,
+};
+
+/**
+ * @brief Body frame of a ZeroMQ message referring to a shared memory slot instead of carrying a
+ * serialized message.
+ * @note It starts with a zero byte, with which no serialized protobuf message starts because field
+ * number 0 is invalid, so both kinds of body frames can be told apart.
+ */
+struct SharedMemoryFrame
+{
+  std::uint8_t tag = 0;
+  SharedMemoryFrameType type = SharedMemoryFrameType::BODY;
+  std::uint8_t padding[6] = {};
+  std::uint64_t slot = 0;
+  std::uint64_t size = 0;
+  char segment_name[64] = {};
+};
+
+auto isSharedMemoryFrame(const void * data, std::size_t size) -> bool;
+
+auto makeSharedMemoryFrame(const SharedMemorySegment &, std::size_t slot, std::size_t size)
+  -> SharedMemoryFrame;
+
+/**
+ * @brief Name of a new shared memory segment, unique among the segments created by this process.
+ */
+auto makeSharedMemorySegmentName() -> std::string;
+}  // namespace simulation_interface
+
+#endif  // SIMULATION_INTERFACE__SHARED_MEMORY_HPP_
@@ -17,24 +17,49 @@
 
 #include <simulation_api_schema.pb.h>
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <future>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
 #include <scenario_simulator_exception/exception.hpp>
 #include <simulation_interface/constants.hpp>
+#include <simulation_interface/rpc_statistics.hpp>
+#include <simulation_interface/shared_memory.hpp>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 #include <zmqpp/zmqpp.hpp>
 
 namespace zeromq
 {
+/**
+ * @brief Client of zeromq::MultiServer.
+ * @note Requests are sent on a DEALER socket with a request id frame, so several requests can be in
+ * flight and each response is matched to its request by id. call() waits for the response, while
+ * callAsync() returns as soon as the request is sent. With TransportProtocol::SHARED_MEMORY and a
+ * server on localhost, bodies are passed through a SharedMemorySegment owned by the client and the
+ * messages only carry SharedMemoryFrame. Before the first request, the client asks the server to
+ * open the segment, and sends bodies in the messages themselves if the server cannot. If
+ * record_statistics is true, the serialization, sending, waiting and parsing time and the message
+ * sizes of each request are recorded by request type.
+ * Requests and responses are framed as ("", request id, body), as documented on SimulationRequest
+ * in simulation_api_schema.proto. This differs from the single body frame of a REQ socket, so a
+ * simulator serving requests on a REP socket cannot talk to this client, with any protocol.
+ * This class is not thread-safe, except for getStatistics().
+ */
 class MultiClient
 {
 public:
   explicit MultiClient(
     const simulation_interface::TransportProtocol & protocol, const std::string & hostname,
-    const unsigned int socket_port);
+    const unsigned int socket_port, const std::size_t max_in_flight_requests = 4,
+    const bool record_statistics = false);
 
   ~MultiClient();
 
@@ -79,15 +104,87 @@ public:
   auto call(const simulation_api_schema::FollowPolylineTrajectoryRequest &)
     -> simulation_api_schema::FollowPolylineTrajectoryResponse;
 
+  /// @note Taken by value, so that a temporary per-frame request is moved into SimulationRequest.
+  auto call(simulation_api_schema::UpdateEntityStatusBatchRequest)
+    -> simulation_api_schema::UpdateEntityStatusBatchResponse;
+
+  /// @note Taken by value, so that a temporary per-frame request is moved into SimulationRequest.
+  auto call(simulation_api_schema::StepRequest) -> simulation_api_schema::StepResponse;
+
+  /**
+   * @brief Send a request without waiting for its response.
+   * @note The returned future is deferred: its get() receives responses in the calling thread until
+   * the response of this request arrives, keeping the responses of other requests for their own
+   * futures. If max_in_flight_requests requests are already in flight, this function first waits
+   * until one of them is answered. The future must not outlive the client.
+   */
+  auto callAsync(const simulation_api_schema::SimulationRequest &)
+    -> std::future<simulation_api_schema::SimulationResponse>;
+
+  auto callAsync(simulation_api_schema::StepRequest)
+    -> std::future<simulation_api_schema::StepResponse>;
+
+  /**
+   * @brief Statistics keyed by the name of the request field in SimulationRequest.
+   * @note Empty unless record_statistics is true.
+   */
+  auto getStatistics() const -> std::map<std::string, simulation_interface::RpcStatistics>;
+
   const simulation_interface::TransportProtocol protocol;
   const std::string hostname;
+  const std::size_t max_in_flight_requests;
 
 private:
+  auto send(const simulation_api_schema::SimulationRequest &) -> std::uint64_t;
+
+  auto receive() -> void;
+
+  auto receive(std::uint64_t request_id) -> simulation_api_schema::SimulationResponse;
+
+  auto openSharedMemory() -> void;
+
   zmqpp::context context_;
   const zmqpp::socket_type type_;
   zmqpp::socket socket_;
 
   bool is_running = true;
+
+  std::uint64_t next_request_id_ = 0;
+
+  std::size_t in_flight_request_count_ = 0;
+
+  /// @note Responses received while waiting for another request, keyed by request id.
+  std::unordered_map<std::uint64_t, simulation_api_schema::SimulationResponse> responses_;
+
+  struct InFlightRequest
+  {
+    simulation_api_schema::SimulationRequest::RequestCase request_case;
+
+    simulation_interface::RpcSample sample;
+
+    std::chrono::steady_clock::time_point sent_time;
+  };
+
+  /// @note Null unless record_statistics is true.
+  std::unique_ptr<simulation_interface::RpcStatisticsRecorder> statistics_;
+
+  /// @note Requests whose responses are not received yet, only when statistics_ is not null.
+  std::unordered_map<std::uint64_t, InFlightRequest> in_flight_requests_;
+
+  /// @note Null unless the shared memory transport is used.
+  std::unique_ptr<simulation_interface::SharedMemorySegment> shared_memory_;
+
+  /// @note True once the server has answered the request to open shared_memory_.
+  bool is_shared_memory_open_ = false;
+
+  /// @note Slots of shared_memory_ not used by any in-flight request.
+  std::vector<std::size_t> free_shared_memory_slots_;
+
+  /// @note Slots of shared_memory_ used by in-flight requests, keyed by request id.
+  std::unordered_map<std::uint64_t, std::size_t> shared_memory_slots_;
+
+  /// @note Each slot holds one request body; larger bodies are sent in the message itself.
+  static constexpr std::size_t shared_memory_slot_size = 8 * 1024 * 1024;
 };
 }  // namespace zeromq
 
@@ -15,47 +15,191 @@
 #ifndef SIMULATION_INTERFACE__ZMQ_MULTI_SERVER_HPP_
 #define SIMULATION_INTERFACE__ZMQ_MULTI_SERVER_HPP_
 
+#include <google/protobuf/arena.h>
 #include <simulation_api_schema.pb.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <rclcpp/rclcpp.hpp>
 #include <scenario_simulator_exception/exception.hpp>
 #include <simulation_interface/constants.hpp>
+#include <simulation_interface/rpc_statistics.hpp>
+#include <simulation_interface/shared_memory.hpp>
+#include <set>
 #include <string>
 #include <thread>
 #include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <zmqpp/zmqpp.hpp>
 
 namespace zeromq
 {
+/**
+ * @brief Server of the simulation API, answering requests in the order they arrive.
+ * @note The socket is a ROUTER, so both REQ clients and pipelining DEALER clients are served. Each
+ * response is sent with the frames preceding the body of its request (routing id, delimiter and
+ * request id, if any), which lets clients match responses to requests. A client using shared memory
+ * first asks the server to open its segment, which the server answers with whether it could. Then a
+ * request whose body is a SharedMemoryFrame is read from the segment, and its response is written
+ * back to the same segment.
+ * The server thread blocks until a request arrives, a worker finishes or the server is destroyed,
+ * each of which wakes it immediately.
+ */
 class MultiServer
 {
 public:
+  using RequestCase = simulation_api_schema::SimulationRequest::RequestCase;
+
+  struct Options
+  {
+    /**
+     * @note Requests of these types are handled by worker threads, concurrently with each other.
+     * Any other request waits until all of them are handled and is handled by the server thread,
+     * so only handlers which are safe to run concurrently with each other should be listed.
+     */
+    std::set<RequestCase> concurrent_requests;
+
+    std::size_t worker_count = 0;
+
+    /**
+     * @note If true, the parsing, waiting, handling, serialization and sending time and the message
+     * sizes of each request are recorded by request type.
+     */
+    bool record_statistics = false;
+  };
+
   template <typename... Ts>
   explicit MultiServer(
     const simulation_interface::TransportProtocol & protocol,
     const simulation_interface::HostName & hostname, const unsigned int socket_port, Ts &&... xs)
+  : MultiServer(protocol, hostname, socket_port, Options(), std::forward<decltype(xs)>(xs)...)
+  {
+  }
+
+  template <typename... Ts>
+  explicit MultiServer(
+    const simulation_interface::TransportProtocol & protocol,
+    const simulation_interface::HostName & hostname, const unsigned int socket_port,
+    Options options, Ts &&... xs)
   : context_(zmqpp::context()),
-    type_(zmqpp::socket_type::reply),
+    type_(zmqpp::socket_type::router),
     socket_(context_, type_),
+    options_(std::move(options)),
+    statistics_(
+      options_.record_statistics ? std::make_unique<simulation_interface::RpcStatisticsRecorder>()
+                                 : nullptr),
     functions_(std::forward<decltype(xs)>(xs)...)
   {
     socket_.bind(simulation_interface::getEndPoint(protocol, hostname, socket_port));
-    poller_.add(socket_);
-    thread_ = std::thread(&MultiServer::start_poll, this);
+    start();
   }
 
   ~MultiServer();
 
+  /**
+   * @brief Statistics keyed by the name of the request field in SimulationRequest.
+   * @note Empty unless Options::record_statistics is true.
+   */
+  auto getStatistics() const -> std::map<std::string, simulation_interface::RpcStatistics>;
+
 private:
-  void poll();
+  struct Job
+  {
+    RequestCase request_case = RequestCase::REQUEST_NOT_SET;
+
+    const simulation_api_schema::SimulationRequest * request = nullptr;
+
+    simulation_api_schema::SimulationResponse response;
+
+    /// @note Frames preceding the body of the request, to which the response body is appended.
+    zmqpp::message envelope;
+
+    simulation_interface::SharedMemorySegment * shared_memory = nullptr;
+
+    simulation_interface::SharedMemoryFrame frame;
+
+    simulation_interface::RpcSample sample;
+
+    std::chrono::steady_clock::time_point parsed_time;
+
+    std::exception_ptr thrown;
+  };
+
+  void start();
+  bool poll();
   void start_poll();
+  void work();
+  void receive();
+  void send(Job &);
+  void sendCompletedJobs();
+  void waitForJobs();
+  void handle(Job &);
+  auto handle(const simulation_api_schema::SimulationRequest &)
+    -> simulation_api_schema::SimulationResponse;
   std::thread thread_;
   const zmqpp::context context_;
   const zmqpp::socket_type type_;
   zmqpp::poller poller_;
   zmqpp::socket socket_;
 
+  const Options options_;
+
+  /// @note eventfd written by the destructor to stop the server thread.
+  int shutdown_event_ = -1;
+
+  /// @note eventfd written by workers when they finish a job.
+  int completion_event_ = -1;
+
+  std::vector<std::thread> workers_;
+
+  std::mutex job_mutex_;
+
+  std::condition_variable job_condition_;
+
+  std::condition_variable completion_condition_;
+
+  std::deque<std::unique_ptr<Job>> jobs_;
+
+  std::deque<std::unique_ptr<Job>> completed_jobs_;
+
+  bool is_stop_requested_ = false;
+
+  /// @note Number of jobs given to workers whose responses are not sent yet.
+  std::size_t pending_job_count_ = 0;
+
+  /// @note Null unless Options::record_statistics is true.
+  const std::unique_ptr<simulation_interface::RpcStatisticsRecorder> statistics_;
+
+  /// @note Shared memory segments of the clients, keyed by name.
+  std::unordered_map<std::string, std::unique_ptr<simulation_interface::SharedMemorySegment>>
+    shared_memories_;
+
+  /// @note Answer a SharedMemoryFrameType::OPEN frame, whether or not the segment can be opened.
+  void openSharedMemory(zmqpp::message & envelope, simulation_interface::SharedMemoryFrame);
+
+  auto getSharedMemory(const simulation_interface::SharedMemoryFrame &)
+    -> simulation_interface::SharedMemorySegment &;
+
+  static auto makeArenaOptions(std::vector<char> & initial_block)
+    -> google::protobuf::ArenaOptions;
+
+  static constexpr std::size_t arena_initial_block_size = 4 * 1024 * 1024;
+
+  /// @note Requests are parsed into arena_, which is reset whenever no worker uses it and keeps
+  /// this block, so parsing a request allocates nothing once requests fit in it.
+  std::vector<char> arena_initial_block_ = std::vector<char>(arena_initial_block_size);
+
+  google::protobuf::Arena arena_{makeArenaOptions(arena_initial_block_)};
+
 #define DEFINE_FUNCTION_TYPE(TYPENAME)                                      \
   using TYPENAME = std::function<simulation_api_schema::TYPENAME##Response( \
     const simulation_api_schema::TYPENAME##Request &)>
@@ -72,13 +216,16 @@ private:
   DEFINE_FUNCTION_TYPE(AttachOccupancyGridSensor);
   DEFINE_FUNCTION_TYPE(UpdateTrafficLights);
   DEFINE_FUNCTION_TYPE(FollowPolylineTrajectory);
+  DEFINE_FUNCTION_TYPE(UpdateEntityStatusBatch);
+  DEFINE_FUNCTION_TYPE(Step);
 
 #undef DEFINE_FUNCTION_TYPE
 
   std::tuple<
     Initialize, UpdateFrame, SpawnVehicleEntity, SpawnPedestrianEntity, SpawnMiscObjectEntity,
     DespawnEntity, UpdateEntityStatus, AttachLidarSensor, AttachDetectionSensor,
-    AttachOccupancyGridSensor, UpdateTrafficLights, FollowPolylineTrajectory>
+    AttachOccupancyGridSensor, UpdateTrafficLights, FollowPolylineTrajectory,
+    UpdateEntityStatusBatch, Step>
     functions_;
 };
 }  // namespace zeromq
@@ -18,18 +18,32 @@
 
 namespace simulation_interface
 {
+/// @note Requests in shared memory are signalled over TCP.
+static std::string getScheme(const TransportProtocol & protocol)
+{
+  if (protocol == TransportProtocol::SHARED_MEMORY) {
+    return enumToString(TransportProtocol::TCP);
+  } else {
+    return enumToString(protocol);
+  }
+}
+
 std::string getEndPoint(
   const TransportProtocol & protocol, const HostName & hostname, const unsigned int & port)
 {
-  return simulation_interface::enumToString(protocol) + "://" +
-         simulation_interface::enumToString(hostname) + ":" + std::to_string(port);
+  return getScheme(protocol) + "://" + simulation_interface::enumToString(hostname) + ":" +
+         std::to_string(port);
 }
 
 std::string getEndPoint(
   const TransportProtocol & protocol, const std::string & hostname, const unsigned int & port)
 {
-  return simulation_interface::enumToString(protocol) + "://" + hostname + ":" +
-         std::to_string(port);
+  return getScheme(protocol) + "://" + hostname + ":" + std::to_string(port);
+}
+
+bool isLocalHost(const std::string & hostname)
+{
+  return hostname == "localhost" or hostname == "127.0.0.1" or hostname == "::1";
 }
 
 std::string enumToString(const TransportProtocol & protocol)
@@ -37,12 +51,14 @@ std::string enumToString(const TransportProtocol & protocol)
   switch (protocol) {
     case TransportProtocol::TCP:
       return "tcp";
+    case TransportProtocol::SHARED_MEMORY:
+      return "shm";
       /*
     case TransportProtocol::UDP:
       return "udp";              
       */
   }
-  THROW_SIMULATION_ERROR("Protocol should be TCP.");  // LCOV_EXCL_LINE
+  THROW_SIMULATION_ERROR("Protocol should be TCP or SHARED_MEMORY.");  // LCOV_EXCL_LINE
 }
 
 std::string enumToString(const HostName & hostname)
@@ -0,0 +1,200 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <iomanip>
+#include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/entity_status_delta.hpp>
+#include <string>
+#include <vector>
+
+namespace simulation_interface
+{
+namespace
+{
+auto equals(const geometry_msgs::Vector3 & a, const geometry_msgs::Vector3 & b) -> bool
+{
+  return a.x() == b.x() and a.y() == b.y() and a.z() == b.z();
+}
+
+auto equals(const geometry_msgs::Point & a, const geometry_msgs::Point & b) -> bool
+{
+  return a.x() == b.x() and a.y() == b.y() and a.z() == b.z();
+}
+
+auto equals(const geometry_msgs::Quaternion & a, const geometry_msgs::Quaternion & b) -> bool
+{
+  return a.x() == b.x() and a.y() == b.y() and a.z() == b.z() and a.w() == b.w();
+}
+
+auto equals(const geometry_msgs::Twist & a, const geometry_msgs::Twist & b) -> bool
+{
+  return equals(a.linear(), b.linear()) and equals(a.angular(), b.angular());
+}
+
+auto equals(const geometry_msgs::Accel & a, const geometry_msgs::Accel & b) -> bool
+{
+  return equals(a.linear(), b.linear()) and equals(a.angular(), b.angular());
+}
+}  // namespace
+
+EntityStatusDeltaEncoder::EntityStatusDeltaEncoder(std::size_t keyframe_interval)
+: keyframe_interval_(std::max<std::size_t>(keyframe_interval, 1))
+{
+}
+
+auto EntityStatusDeltaEncoder::encode(
+  const std::vector<simulation_api_schema::EntityStatus> & statuses, double time)
+  -> simulation_api_schema::EntityStatusDeltaFrame
+{
+  using Field = simulation_api_schema::EntityStatusDelta;
+  simulation_api_schema::EntityStatusDeltaFrame frame;
+  const auto keyframe = frame_count_ % keyframe_interval_ == 0;
+  const auto frame_index = frame_count_++;
+  frame.set_keyframe(keyframe);
+  frame.set_time(time);
+  if (keyframe) {
+    /// @note Ids of the entities which are not in this frame are forgotten by the decoder.
+    entries_.clear();
+    next_id_ = 0;
+  }
+  frame.mutable_delta()->Reserve(static_cast<int>(statuses.size()));
+  for (const auto & status : statuses) {
+    auto & delta = *frame.add_delta();
+    std::uint32_t fields = Field::NONE;
+    auto iter = entries_.find(status.name());
+    if (
+      iter == entries_.end() or iter->second.last_frame + 1 != frame_index or
+      iter->second.status.type().type() != status.type().type() or
+      iter->second.status.subtype().value() != status.subtype().value()) {
+      /// @note An entity missing in the previous frame may have been despawned and respawned.
+      iter = entries_.insert_or_assign(status.name(), Entry{next_id_++, status, frame_index}).first;
+      fields = Field::DECLARATION | Field::POSITION | Field::ORIENTATION | Field::TWIST |
+               Field::ACCEL | Field::LINEAR_JERK | Field::CURRENT_ACTION;
+    } else {
+      const auto & previous = iter->second.status;
+      if (not equals(previous.pose().position(), status.pose().position())) {
+        fields |= Field::POSITION;
+      }
+      if (not equals(previous.pose().orientation(), status.pose().orientation())) {
+        fields |= Field::ORIENTATION;
+      }
+      if (not equals(previous.action_status().twist(), status.action_status().twist())) {
+        fields |= Field::TWIST;
+      }
+      if (not equals(previous.action_status().accel(), status.action_status().accel())) {
+        fields |= Field::ACCEL;
+      }
+      if (previous.action_status().linear_jerk() != status.action_status().linear_jerk()) {
+        fields |= Field::LINEAR_JERK;
+      }
+      if (previous.action_status().current_action() != status.action_status().current_action()) {
+        fields |= Field::CURRENT_ACTION;
+      }
+      iter->second.status = status;
+      iter->second.last_frame = frame_index;
+    }
+    delta.set_id(iter->second.id);
+    delta.set_fields(fields);
+    if (fields & Field::DECLARATION) {
+      delta.set_name(status.name());
+      *delta.mutable_type() = status.type();
+      *delta.mutable_subtype() = status.subtype();
+    }
+    if ((fields & Field::POSITION) and status.pose().has_position()) {
+      *delta.mutable_position() = status.pose().position();
+    }
+    if ((fields & Field::ORIENTATION) and status.pose().has_orientation()) {
+      *delta.mutable_orientation() = status.pose().orientation();
+    }
+    if ((fields & Field::TWIST) and status.action_status().has_twist()) {
+      *delta.mutable_twist() = status.action_status().twist();
+    }
+    if ((fields & Field::ACCEL) and status.action_status().has_accel()) {
+      *delta.mutable_accel() = status.action_status().accel();
+    }
+    if (fields & Field::LINEAR_JERK) {
+      delta.set_linear_jerk(status.action_status().linear_jerk());
+    }
+    if (fields & Field::CURRENT_ACTION) {
+      delta.set_current_action(status.action_status().current_action());
+    }
+  }
+  return frame;
+}
+
+auto EntityStatusDeltaDecoder::decode(const simulation_api_schema::EntityStatusDeltaFrame & frame)
+  -> std::vector<simulation_api_schema::EntityStatus>
+{
+  using Field = simulation_api_schema::EntityStatusDelta;
+  if (frame.keyframe()) {
+    statuses_.clear();
+  }
+  std::vector<simulation_api_schema::EntityStatus> statuses;
+  statuses.reserve(frame.delta_size());
+  for (const auto & delta : frame.delta()) {
+    if (delta.fields() & Field::DECLARATION) {
+      auto & status = statuses_[delta.id()];
+      status.Clear();
+      status.set_name(delta.name());
+      *status.mutable_type() = delta.type();
+      *status.mutable_subtype() = delta.subtype();
+    }
+    auto iter = statuses_.find(delta.id());
+    if (iter == statuses_.end()) {
+      THROW_SIMULATION_ERROR(
+        "Entity status delta refers to undeclared id ", delta.id(),
+        ". Entity status delta frames should be decoded in the order they are encoded.");
+    }
+    auto & status = iter->second;
+    status.set_time(frame.time());
+    if (delta.fields() & Field::POSITION) {
+      if (delta.has_position()) {
+        *status.mutable_pose()->mutable_position() = delta.position();
+      } else {
+        status.mutable_pose()->clear_position();
+      }
+    }
+    if (delta.fields() & Field::ORIENTATION) {
+      if (delta.has_orientation()) {
+        *status.mutable_pose()->mutable_orientation() = delta.orientation();
+      } else {
+        status.mutable_pose()->clear_orientation();
+      }
+    }
+    if (delta.fields() & Field::TWIST) {
+      if (delta.has_twist()) {
+        *status.mutable_action_status()->mutable_twist() = delta.twist();
+      } else {
+        status.mutable_action_status()->clear_twist();
+      }
+    }
+    if (delta.fields() & Field::ACCEL) {
+      if (delta.has_accel()) {
+        *status.mutable_action_status()->mutable_accel() = delta.accel();
+      } else {
+        status.mutable_action_status()->clear_accel();
+      }
+    }
+    if (delta.fields() & Field::LINEAR_JERK) {
+      status.mutable_action_status()->set_linear_jerk(delta.linear_jerk());
+    }
+    if (delta.fields() & Field::CURRENT_ACTION) {
+      status.mutable_action_status()->set_current_action(delta.current_action());
+    }
+    statuses.push_back(status);
+  }
+  return statuses;
+}
+}  // namespace simulation_interface
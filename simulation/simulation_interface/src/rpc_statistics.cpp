@@ -0,0 +1,212 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/rpc_statistics.hpp>
+#include <sstream>
+#include <utility>
+
+namespace simulation_interface
+{
+auto LatencyHistogram::getBucketIndex(std::uint64_t value) -> std::size_t
+{
+  if (value < (std::uint64_t(1) << (sub_bucket_bits + 1))) {
+    return value;
+  } else {
+    const std::size_t shift = 63 - __builtin_clzll(value) - sub_bucket_bits;
+    return (shift << sub_bucket_bits) + (value >> shift);
+  }
+}
+
+auto LatencyHistogram::getBucketUpperBound(std::size_t index) -> std::uint64_t
+{
+  if (index < (std::size_t(1) << (sub_bucket_bits + 1))) {
+    return index;
+  } else {
+    const std::size_t shift = (index >> sub_bucket_bits) - 1;
+    const std::uint64_t mantissa = index - (shift << sub_bucket_bits);
+    return ((mantissa + 1) << shift) - 1;
+  }
+}
+
+auto LatencyHistogram::record(std::chrono::nanoseconds duration) -> void
+{
+  duration = std::max(duration, std::chrono::nanoseconds(0));
+  ++counts_[getBucketIndex(static_cast<std::uint64_t>(duration.count()))];
+  ++count_;
+  total_ += duration;
+  max_ = std::max(max_, duration);
+}
+
+auto LatencyHistogram::getMean() const -> std::chrono::nanoseconds
+{
+  return count_ == 0 ? std::chrono::nanoseconds(0)
+                     : total_ / static_cast<std::chrono::nanoseconds::rep>(count_);
+}
+
+auto LatencyHistogram::getPercentile(double quantile) const -> std::chrono::nanoseconds
+{
+  if (count_ == 0) {
+    return std::chrono::nanoseconds(0);
+  }
+  const auto target = std::max<std::uint64_t>(
+    1, static_cast<std::uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * count_)));
+  std::uint64_t accumulated = 0;
+  for (std::size_t index = 0; index < counts_.size(); ++index) {
+    if ((accumulated += counts_[index]) >= target) {
+      return std::min(
+        std::chrono::nanoseconds(static_cast<std::int64_t>(getBucketUpperBound(index))), max_);
+    }
+  }
+  return max_;
+}
+
+auto RpcStatistics::add(const RpcSample & sample) -> void
+{
+  ++count;
+  request_bytes += sample.request_bytes;
+  response_bytes += sample.response_bytes;
+  for (const auto & [duration, histogram] :
+       {std::make_pair(sample.serialize, &serialize), std::make_pair(sample.send, &send),
+        std::make_pair(sample.wait, &wait), std::make_pair(sample.handle, &handle),
+        std::make_pair(sample.parse, &parse)}) {
+    if (duration) {
+      histogram->record(duration.value());
+    }
+  }
+}
+
+auto RpcStatisticsRecorder::record(RequestCase request_case, const RpcSample & sample) -> void
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics_[request_case].add(sample);
+}
+
+auto RpcStatisticsRecorder::getStatistics() const -> std::map<std::string, RpcStatistics>
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::map<std::string, RpcStatistics> statistics;
+  for (const auto & [request_case, request_statistics] : statistics_) {
+    if (request_case == RequestCase::REQUEST_NOT_SET) {
+      statistics.emplace("request_not_set", request_statistics);
+    } else {
+      statistics.emplace(
+        simulation_api_schema::SimulationRequest::descriptor()
+          ->FindFieldByNumber(static_cast<int>(request_case))
+          ->name(),
+        request_statistics);
+    }
+  }
+  return statistics;
+}
+
+namespace
+{
+auto getPhases(const RpcStatistics & statistics)
+{
+  return std::array<std::pair<const char *, const LatencyHistogram *>, 5>{
+    {{"serialize", &statistics.serialize},
+     {"send", &statistics.send},
+     {"wait", &statistics.wait},
+     {"handle", &statistics.handle},
+     {"parse", &statistics.parse}}};
+}
+
+constexpr std::array<std::pair<const char *, double>, 3> percentiles = {
+  {{"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}}};
+}  // namespace
+
+auto toJson(const std::map<std::string, RpcStatistics> & statistics) -> nlohmann::json
+{
+  auto json = nlohmann::json::object();
+  for (const auto & [name, request_statistics] : statistics) {
+    auto & request_json = json[name];
+    request_json["count"] = request_statistics.count;
+    request_json["request_bytes"] = request_statistics.request_bytes;
+    request_json["response_bytes"] = request_statistics.response_bytes;
+    for (const auto & [phase, histogram] : getPhases(request_statistics)) {
+      if (histogram->getCount() != 0) {
+        auto & phase_json = request_json[phase];
+        phase_json["count"] = histogram->getCount();
+        phase_json["mean_ns"] = histogram->getMean().count();
+        for (const auto & [percentile, quantile] : percentiles) {
+          phase_json[std::string(percentile) + "_ns"] =
+            histogram->getPercentile(quantile).count();
+        }
+        phase_json["max_ns"] = histogram->getMax().count();
+      }
+    }
+  }
+  return json;
+}
+
+auto toDiagnosticStatuses(
+  const std::string & name, const std::map<std::string, RpcStatistics> & statistics)
+  -> std::vector<diagnostic_msgs::msg::DiagnosticStatus>
+{
+  const auto to_milliseconds = [](std::chrono::nanoseconds duration) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3)
+       << std::chrono::duration<double, std::milli>(duration).count();
+    return ss.str();
+  };
+  const auto make_key_value = [](const std::string & key, const std::string & value) {
+    diagnostic_msgs::msg::KeyValue key_value;
+    key_value.key = key;
+    key_value.value = value;
+    return key_value;
+  };
+  std::vector<diagnostic_msgs::msg::DiagnosticStatus> statuses;
+  for (const auto & [request_name, request_statistics] : statistics) {
+    auto & status = statuses.emplace_back();
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+    status.name = name + ": " + request_name;
+    status.hardware_id = name;
+    status.message = std::to_string(request_statistics.count) + " requests";
+    status.values.push_back(make_key_value("count", std::to_string(request_statistics.count)));
+    status.values.push_back(
+      make_key_value("request_bytes", std::to_string(request_statistics.request_bytes)));
+    status.values.push_back(
+      make_key_value("response_bytes", std::to_string(request_statistics.response_bytes)));
+    for (const auto & [phase, histogram] : getPhases(request_statistics)) {
+      if (histogram->getCount() != 0) {
+        const auto prefix = std::string(phase) + "_";
+        status.values.push_back(
+          make_key_value(prefix + "mean_ms", to_milliseconds(histogram->getMean())));
+        for (const auto & [percentile, quantile] : percentiles) {
+          status.values.push_back(make_key_value(
+            prefix + percentile + "_ms", to_milliseconds(histogram->getPercentile(quantile))));
+        }
+        status.values.push_back(
+          make_key_value(prefix + "max_ms", to_milliseconds(histogram->getMax())));
+      }
+    }
+  }
+  return statuses;
+}
+
+auto writeJson(const std::string & path, const std::map<std::string, RpcStatistics> & statistics)
+  -> void
+{
+  if (std::ofstream file(path); file) {
+    file << toJson(statistics).dump(2) << std::endl;
+  } else {
+    THROW_SIMULATION_ERROR("Failed to write RPC statistics to ", std::quoted(path), ".");
+  }
+}
+}  // namespace simulation_interface
@@ -0,0 +1,136 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/shared_memory.hpp>
+#include <string>
+
+namespace simulation_interface
+{
+SharedMemorySegment::SharedMemorySegment(
+  const std::string & name, std::size_t slot_count, std::size_t slot_size)
+: name_(name), is_owner_(true), slot_count_(slot_count), slot_size_(slot_size)
+{
+  if (name.size() >= sizeof(SharedMemoryFrame::segment_name)) {
+    THROW_SIMULATION_ERROR("Shared memory segment name ", std::quoted(name), " is too long.");
+  }
+  const auto file_descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (file_descriptor < 0) {
+    THROW_SIMULATION_ERROR(
+      "Failed to create shared memory segment ", std::quoted(name), ": ", std::strerror(errno));
+  }
+  size_ = sizeof(Header) + 2 * slot_count * slot_size;
+  if (ftruncate(file_descriptor, static_cast<off_t>(size_)) != 0) {
+    const auto error = errno;
+    close(file_descriptor);
+    shm_unlink(name.c_str());
+    THROW_SIMULATION_ERROR(
+      "Failed to resize shared memory segment ", std::quoted(name), ": ", std::strerror(error));
+  }
+  map(file_descriptor);
+  *reinterpret_cast<Header *>(data_) = Header{slot_count, slot_size};
+}
+
+SharedMemorySegment::SharedMemorySegment(const std::string & name) : name_(name), is_owner_(false)
+{
+  const auto file_descriptor = shm_open(name.c_str(), O_RDWR, 0);
+  if (file_descriptor < 0) {
+    THROW_SIMULATION_ERROR(
+      "Failed to open shared memory segment ", std::quoted(name), ": ", std::strerror(errno));
+  }
+  struct stat status;
+  if (fstat(file_descriptor, &status) != 0 or status.st_size < static_cast<off_t>(sizeof(Header))) {
+    close(file_descriptor);
+    THROW_SIMULATION_ERROR("Shared memory segment ", std::quoted(name), " is broken.");
+  }
+  size_ = static_cast<std::size_t>(status.st_size);
+  map(file_descriptor);
+  const auto header = *reinterpret_cast<const Header *>(data_);
+  slot_count_ = header.slot_count;
+  slot_size_ = header.slot_size;
+  if (sizeof(Header) + 2 * slot_count_ * slot_size_ > size_) {
+    THROW_SIMULATION_ERROR("Shared memory segment ", std::quoted(name), " is broken.");
+  }
+}
+
+SharedMemorySegment::~SharedMemorySegment()
+{
+  if (data_) {
+    munmap(data_, size_);
+  }
+  if (is_owner_) {
+    shm_unlink(name_.c_str());
+  }
+}
+
+auto SharedMemorySegment::map(int file_descriptor) -> void
+{
+  auto data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+  close(file_descriptor);
+  if (data == MAP_FAILED) {
+    if (is_owner_) {
+      shm_unlink(name_.c_str());
+    }
+    THROW_SIMULATION_ERROR(
+      "Failed to map shared memory segment ", std::quoted(name_), ": ", std::strerror(errno));
+  }
+  data_ = static_cast<std::uint8_t *>(data);
+}
+
+auto SharedMemorySegment::getRequestSlot(std::size_t slot) const -> std::uint8_t *
+{
+  if (slot_count_ <= slot) {
+    THROW_SIMULATION_ERROR("Shared memory slot ", slot, " is out of range.");
+  }
+  return data_ + sizeof(Header) + slot * slot_size_;
+}
+
+auto SharedMemorySegment::getResponseSlot(std::size_t slot) const -> std::uint8_t *
+{
+  if (slot_count_ <= slot) {
+    THROW_SIMULATION_ERROR("Shared memory slot ", slot, " is out of range.");
+  }
+  return data_ + sizeof(Header) + (slot_count_ + slot) * slot_size_;
+}
+
+auto isSharedMemoryFrame(const void * data, std::size_t size) -> bool
+{
+  return size == sizeof(SharedMemoryFrame) and *static_cast<const std::uint8_t *>(data) == 0;
+}
+
+auto makeSharedMemoryFrame(const SharedMemorySegment & segment, std::size_t slot, std::size_t size)
+  -> SharedMemoryFrame
+{
+  SharedMemoryFrame frame;
+  frame.slot = slot;
+  frame.size = size;
+  std::strncpy(frame.segment_name, segment.getName().c_str(), sizeof(frame.segment_name) - 1);
+  return frame;
+}
+
+auto makeSharedMemorySegmentName() -> std::string
+{
+  static std::atomic<std::size_t> count{0};
+  return "/simulation_interface_" + std::to_string(getpid()) + "_" + std::to_string(count++);
+}
+}  // namespace simulation_interface
@@ -12,22 +12,47 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <rclcpp/utilities.hpp>
 #include <simulation_interface/conversions.hpp>
 #include <simulation_interface/zmq_multi_client.hpp>
 #include <string>
+#include <utility>
+
 namespace zeromq
 {
 MultiClient::MultiClient(
   const simulation_interface::TransportProtocol & protocol, const std::string & hostname,
-  const unsigned int socket_port)
+  const unsigned int socket_port, const std::size_t max_in_flight_requests,
+  const bool record_statistics)
 : protocol(protocol),
   hostname(hostname),
+  max_in_flight_requests(std::max<std::size_t>(max_in_flight_requests, 1)),
   context_(zmqpp::context()),
-  type_(zmqpp::socket_type::request),
-  socket_(context_, type_)
+  type_(zmqpp::socket_type::dealer),
+  socket_(context_, type_),
+  statistics_(
+    record_statistics ? std::make_unique<simulation_interface::RpcStatisticsRecorder>() : nullptr)
 {
   socket_.connect(simulation_interface::getEndPoint(protocol, hostname, socket_port));
+  if (
+    protocol == simulation_interface::TransportProtocol::SHARED_MEMORY and
+    simulation_interface::isLocalHost(hostname)) {
+    try {
+      shared_memory_ = std::make_unique<simulation_interface::SharedMemorySegment>(
+        simulation_interface::makeSharedMemorySegmentName(), this->max_in_flight_requests,
+        shared_memory_slot_size);
+      for (auto slot = shared_memory_->getSlotCount(); 0 < slot; --slot) {
+        free_shared_memory_slots_.push_back(slot - 1);
+      }
+    } catch (const common::SimulationError & error) {
+      RCLCPP_WARN_STREAM(
+        rclcpp::get_logger("simulation_interface"),
+        error.what() << " Falling back to sending requests over TCP.");
+    }
+  }
 }
 
 void MultiClient::closeConnection()
@@ -35,19 +60,189 @@ void MultiClient::closeConnection()
   if (is_running) {
     is_running = false;
     socket_.close();
+    responses_.clear();
+    in_flight_requests_.clear();
+    shared_memory_slots_.clear();
+    free_shared_memory_slots_.clear();
+    shared_memory_.reset();
   }
 }
 
 MultiClient::~MultiClient() { closeConnection(); }
 
+auto MultiClient::getStatistics() const
+  -> std::map<std::string, simulation_interface::RpcStatistics>
+{
+  return statistics_ ? statistics_->getStatistics()
+                     : std::map<std::string, simulation_interface::RpcStatistics>();
+}
+
 auto MultiClient::call(const simulation_api_schema::SimulationRequest & req)
   -> simulation_api_schema::SimulationResponse
 {
-  zmqpp::message message = toZMQ(req);
+  return receive(send(req));
+}
+
+auto MultiClient::callAsync(const simulation_api_schema::SimulationRequest & req)
+  -> std::future<simulation_api_schema::SimulationResponse>
+{
+  if (is_running) {
+    return std::async(
+      std::launch::deferred, [this, request_id = send(req)]() { return receive(request_id); });
+  } else {
+    return std::async(
+      std::launch::deferred, []() { return simulation_api_schema::SimulationResponse(); });
+  }
+}
+
+auto MultiClient::callAsync(simulation_api_schema::StepRequest request)
+  -> std::future<simulation_api_schema::StepResponse>
+{
+  if (is_running) {
+    simulation_api_schema::SimulationRequest sim_request;
+    *sim_request.mutable_step() = std::move(request);
+    return std::async(
+      std::launch::deferred,
+      [this, request_id = send(sim_request)]() {
+        auto sim_response = receive(request_id);
+        return std::move(*sim_response.mutable_step());
+      });
+  } else {
+    return std::async(
+      std::launch::deferred, []() { return simulation_api_schema::StepResponse(); });
+  }
+}
+
+auto MultiClient::send(const simulation_api_schema::SimulationRequest & req) -> std::uint64_t
+{
+  if (shared_memory_ and not is_shared_memory_open_) {
+    openSharedMemory();
+  }
+  while (in_flight_request_count_ >= max_in_flight_requests) {
+    receive();
+  }
+  const auto request_id = next_request_id_++;
+  const auto start_time = statistics_ ? std::chrono::steady_clock::now()
+                                      : std::chrono::steady_clock::time_point();
+  /// @note Same frames as a REQ socket sends (empty delimiter, then body) plus the request id.
+  zmqpp::message message;
+  message << "" << request_id;
+  const auto size = req.ByteSizeLong();
+  if (shared_memory_ and size <= shared_memory_->getSlotSize()) {
+    /// @note Never empty, since there are as many slots as max_in_flight_requests.
+    const auto slot = free_shared_memory_slots_.back();
+    free_shared_memory_slots_.pop_back();
+    shared_memory_slots_.emplace(request_id, slot);
+    req.SerializeToArray(shared_memory_->getRequestSlot(slot), static_cast<int>(size));
+    const auto frame = simulation_interface::makeSharedMemoryFrame(*shared_memory_, slot, size);
+    message.add_raw(&frame, sizeof(frame));
+  } else {
+    addFrame(message, req);
+  }
+  if (statistics_) {
+    const auto serialized_time = std::chrono::steady_clock::now();
+    socket_.send(message);
+    auto & in_flight_request = in_flight_requests_[request_id];
+    in_flight_request.request_case = req.request_case();
+    in_flight_request.sent_time = std::chrono::steady_clock::now();
+    in_flight_request.sample.serialize = serialized_time - start_time;
+    in_flight_request.sample.send = in_flight_request.sent_time - serialized_time;
+    in_flight_request.sample.request_bytes = size;
+  } else {
+    socket_.send(message);
+  }
+  ++in_flight_request_count_;
+  return request_id;
+}
+
+auto MultiClient::receive() -> void
+{
+  zmqpp::message message;
+  socket_.receive(message);
+  const auto received_time = statistics_ ? std::chrono::steady_clock::now()
+                                         : std::chrono::steady_clock::time_point();
+  if (message.parts() != 3) {
+    THROW_SIMULATION_ERROR(
+      "Response from the simulator should have 3 frames, but it has ", message.parts(), ".");
+  }
+  std::uint64_t request_id;
+  message.get(request_id, 1);
+  simulation_api_schema::SimulationResponse response;
+  auto response_bytes = message.size(2);
+  if (simulation_interface::isSharedMemoryFrame(message.raw_data(2), message.size(2))) {
+    if (not shared_memory_) {
+      THROW_SIMULATION_ERROR("Response from the simulator refers to unknown shared memory.");
+    }
+    simulation_interface::SharedMemoryFrame frame;
+    std::memcpy(&frame, message.raw_data(2), sizeof(frame));
+    if (shared_memory_->getSlotSize() < frame.size) {
+      THROW_SIMULATION_ERROR("Response from the simulator is larger than its shared memory slot.");
+    }
+    response_bytes = frame.size;
+    response.ParseFromArray(
+      shared_memory_->getResponseSlot(frame.slot), static_cast<int>(frame.size));
+  } else {
+    parseFrame(message, 2, response);
+  }
+  if (const auto iter = shared_memory_slots_.find(request_id); iter != shared_memory_slots_.end()) {
+    free_shared_memory_slots_.push_back(iter->second);
+    shared_memory_slots_.erase(iter);
+  }
+  if (statistics_) {
+    if (const auto iter = in_flight_requests_.find(request_id); iter != in_flight_requests_.end()) {
+      auto & [request_case, sample, sent_time] = iter->second;
+      sample.wait = received_time - sent_time;
+      sample.parse = std::chrono::steady_clock::now() - received_time;
+      sample.response_bytes = response_bytes;
+      statistics_->record(request_case, sample);
+      in_flight_requests_.erase(iter);
+    }
+  }
+  responses_.emplace(request_id, std::move(response));
+  --in_flight_request_count_;
+}
+
+auto MultiClient::openSharedMemory() -> void
+{
+  /// @note Sent before the first request, so the answer is the next message received.
+  auto frame = simulation_interface::makeSharedMemoryFrame(*shared_memory_, 0, 0);
+  frame.type = simulation_interface::SharedMemoryFrameType::OPEN;
+  zmqpp::message message;
+  message << "" << next_request_id_++;
+  message.add_raw(&frame, sizeof(frame));
   socket_.send(message);
-  zmqpp::message buffer;
-  socket_.receive(buffer);
-  return toProto<simulation_api_schema::SimulationResponse>(buffer);
+  zmqpp::message answer;
+  socket_.receive(answer);
+  if (
+    answer.parts() != 3 or
+    not simulation_interface::isSharedMemoryFrame(answer.raw_data(2), answer.size(2))) {
+    THROW_SIMULATION_ERROR("Simulator should answer a request to open shared memory with a frame.");
+  }
+  std::memcpy(&frame, answer.raw_data(2), sizeof(frame));
+  if (frame.type != simulation_interface::SharedMemoryFrameType::OPENED) {
+    RCLCPP_WARN_STREAM(
+      rclcpp::get_logger("simulation_interface"),
+      "Simulator cannot open shared memory " << shared_memory_->getName()
+                                             << ". Falling back to sending requests over TCP.");
+    free_shared_memory_slots_.clear();
+    shared_memory_.reset();
+  }
+  is_shared_memory_open_ = true;
+}
+
+auto MultiClient::receive(std::uint64_t request_id) -> simulation_api_schema::SimulationResponse
+{
+  auto iter = responses_.find(request_id);
+  while (iter == responses_.end()) {
+    if (not is_running) {
+      return {};
+    }
+    receive();
+    iter = responses_.find(request_id);
+  }
+  auto response = std::move(iter->second);
+  responses_.erase(iter);
+  return response;
 }
 
 auto MultiClient::call(const simulation_api_schema::InitializeRequest & request)
@@ -193,4 +388,30 @@ auto MultiClient::call(const simulation_api_schema::FollowPolylineTrajectoryRequ
     return {};
   }
 }
+
+auto MultiClient::call(simulation_api_schema::UpdateEntityStatusBatchRequest request)
+  -> simulation_api_schema::UpdateEntityStatusBatchResponse
+{
+  if (is_running) {
+    simulation_api_schema::SimulationRequest sim_request;
+    *sim_request.mutable_update_entity_status_batch() = std::move(request);
+    auto sim_response = call(sim_request);
+    return std::move(*sim_response.mutable_update_entity_status_batch());
+  } else {
+    return {};
+  }
+}
+
+auto MultiClient::call(simulation_api_schema::StepRequest request)
+  -> simulation_api_schema::StepResponse
+{
+  if (is_running) {
+    simulation_api_schema::SimulationRequest sim_request;
+    *sim_request.mutable_step() = std::move(request);
+    auto sim_response = call(sim_request);
+    return std::move(*sim_response.mutable_step());
+  } else {
+    return {};
+  }
+}
 }  // namespace zeromq
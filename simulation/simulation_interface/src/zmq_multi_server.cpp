@@ -12,77 +12,342 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <simulation_interface/conversions.hpp>
 #include <simulation_interface/zmq_multi_server.hpp>
 #include <status_monitor/status_monitor.hpp>
+#include <string>
 
 namespace zeromq
 {
-MultiServer::~MultiServer() { thread_.join(); }
+void MultiServer::start()
+{
+  shutdown_event_ = eventfd(0, EFD_NONBLOCK);
+  completion_event_ = eventfd(0, EFD_NONBLOCK);
+  if (shutdown_event_ < 0 or completion_event_ < 0) {
+    THROW_SIMULATION_ERROR("Failed to create eventfd: ", std::strerror(errno));
+  }
+  poller_.add(socket_);
+  poller_.add(shutdown_event_);
+  poller_.add(completion_event_);
+  if (not options_.concurrent_requests.empty()) {
+    for (std::size_t i = 0; i < options_.worker_count; ++i) {
+      workers_.emplace_back(&MultiServer::work, this);
+    }
+  }
+  thread_ = std::thread(&MultiServer::start_poll, this);
+}
+
+MultiServer::~MultiServer()
+{
+  const std::uint64_t value = 1;
+  [[maybe_unused]] const auto written = write(shutdown_event_, &value, sizeof(value));
+  thread_.join();
+  {
+    std::lock_guard<std::mutex> lock(job_mutex_);
+    is_stop_requested_ = true;
+  }
+  job_condition_.notify_all();
+  for (auto && worker : workers_) {
+    worker.join();
+  }
+  close(shutdown_event_);
+  close(completion_event_);
+}
+
+auto MultiServer::getStatistics() const
+  -> std::map<std::string, simulation_interface::RpcStatistics>
+{
+  return statistics_ ? statistics_->getStatistics()
+                     : std::map<std::string, simulation_interface::RpcStatistics>();
+}
+
+auto MultiServer::makeArenaOptions(std::vector<char> & initial_block)
+  -> google::protobuf::ArenaOptions
+{
+  google::protobuf::ArenaOptions options;
+  options.initial_block = initial_block.data();
+  options.initial_block_size = initial_block.size();
+  return options;
+}
+
+static auto getSegmentName(const simulation_interface::SharedMemoryFrame & frame) -> std::string
+{
+  return std::string(frame.segment_name, strnlen(frame.segment_name, sizeof(frame.segment_name)));
+}
+
+void MultiServer::openSharedMemory(
+  zmqpp::message & envelope, simulation_interface::SharedMemoryFrame frame)
+{
+  const auto name = getSegmentName(frame);
+  try {
+    if (not shared_memories_.count(name)) {
+      shared_memories_.emplace(
+        name, std::make_unique<simulation_interface::SharedMemorySegment>(name));
+    }
+    frame.type = simulation_interface::SharedMemoryFrameType::OPENED;
+  } catch (const common::SimulationError & error) {
+    RCLCPP_WARN_STREAM(
+      rclcpp::get_logger("simulation_interface"),
+      error.what() << " The client sends requests over TCP instead.");
+    frame.type = simulation_interface::SharedMemoryFrameType::OPEN_FAILED;
+  }
+  envelope.add_raw(&frame, sizeof(frame));
+  socket_.send(envelope);
+}
+
+auto MultiServer::getSharedMemory(const simulation_interface::SharedMemoryFrame & frame)
+  -> simulation_interface::SharedMemorySegment &
+{
+  const auto iter = shared_memories_.find(getSegmentName(frame));
+  if (iter == shared_memories_.end()) {
+    THROW_SIMULATION_ERROR("SimulationRequest message refers to shared memory not opened.");
+  }
+  if (iter->second->getSlotSize() < frame.size) {
+    THROW_SIMULATION_ERROR("SimulationRequest message is larger than its shared memory slot.");
+  }
+  return *iter->second;
+}
+
+void MultiServer::handle(Job & job)
+{
+  if (statistics_) {
+    const auto start_time = std::chrono::steady_clock::now();
+    job.response = handle(*job.request);
+    job.sample.wait = start_time - job.parsed_time;
+    job.sample.handle = std::chrono::steady_clock::now() - start_time;
+  } else {
+    job.response = handle(*job.request);
+  }
+}
+
+auto MultiServer::handle(const simulation_api_schema::SimulationRequest & proto)
+  -> simulation_api_schema::SimulationResponse
+{
+  simulation_api_schema::SimulationResponse sim_response;
+  switch (proto.request_case()) {
+    case simulation_api_schema::SimulationRequest::RequestCase::kInitialize:
+      *sim_response.mutable_initialize() = std::get<Initialize>(functions_)(proto.initialize());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kUpdateFrame:
+      *sim_response.mutable_update_frame() =
+        std::get<UpdateFrame>(functions_)(proto.update_frame());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kSpawnVehicleEntity:
+      *sim_response.mutable_spawn_vehicle_entity() =
+        std::get<SpawnVehicleEntity>(functions_)(proto.spawn_vehicle_entity());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kSpawnPedestrianEntity:
+      *sim_response.mutable_spawn_pedestrian_entity() =
+        std::get<SpawnPedestrianEntity>(functions_)(proto.spawn_pedestrian_entity());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kSpawnMiscObjectEntity:
+      *sim_response.mutable_spawn_misc_object_entity() =
+        std::get<SpawnMiscObjectEntity>(functions_)(proto.spawn_misc_object_entity());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kDespawnEntity:
+      *sim_response.mutable_despawn_entity() =
+        std::get<DespawnEntity>(functions_)(proto.despawn_entity());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kUpdateEntityStatus:
+      *sim_response.mutable_update_entity_status() =
+        std::get<UpdateEntityStatus>(functions_)(proto.update_entity_status());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kAttachLidarSensor:
+      *sim_response.mutable_attach_lidar_sensor() =
+        std::get<AttachLidarSensor>(functions_)(proto.attach_lidar_sensor());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kAttachDetectionSensor:
+      *sim_response.mutable_attach_detection_sensor() =
+        std::get<AttachDetectionSensor>(functions_)(proto.attach_detection_sensor());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kAttachOccupancyGridSensor:
+      *sim_response.mutable_attach_occupancy_grid_sensor() =
+        std::get<AttachOccupancyGridSensor>(functions_)(proto.attach_occupancy_grid_sensor());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kUpdateTrafficLights:
+      *sim_response.mutable_update_traffic_lights() =
+        std::get<UpdateTrafficLights>(functions_)(proto.update_traffic_lights());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kFollowPolylineTrajectory:
+      *sim_response.mutable_follow_polyline_trajectory() =
+        std::get<FollowPolylineTrajectory>(functions_)(proto.follow_polyline_trajectory());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kUpdateEntityStatusBatch:
+      *sim_response.mutable_update_entity_status_batch() =
+        std::get<UpdateEntityStatusBatch>(functions_)(proto.update_entity_status_batch());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kStep:
+      *sim_response.mutable_step() = std::get<Step>(functions_)(proto.step());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::REQUEST_NOT_SET: {
+      THROW_SIMULATION_ERROR("No case defined for oneof in SimulationRequest message");
+    }
+  }
+  return sim_response;
+}
 
-void MultiServer::poll()
+bool MultiServer::poll()
 {
-  constexpr long timeout_ms = 1L;
+  /// @note Wake up at least once a second so that the status monitor knows this thread is alive.
+  constexpr long timeout_ms = 1000L;
   poller_.poll(timeout_ms);
+  if (poller_.has_input(shutdown_event_)) {
+    return false;
+  }
+  if (poller_.has_input(completion_event_)) {
+    sendCompletedJobs();
+  }
   if (poller_.has_input(socket_)) {
-    simulation_api_schema::SimulationResponse sim_response;
-    zmqpp::message sim_request;
-    socket_.receive(sim_request);
-    auto proto = toProto<simulation_api_schema::SimulationRequest>(sim_request);
-    switch (proto.request_case()) {
-      case simulation_api_schema::SimulationRequest::RequestCase::kInitialize:
-        *sim_response.mutable_initialize() = std::get<Initialize>(functions_)(proto.initialize());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kUpdateFrame:
-        *sim_response.mutable_update_frame() =
-          std::get<UpdateFrame>(functions_)(proto.update_frame());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kSpawnVehicleEntity:
-        *sim_response.mutable_spawn_vehicle_entity() =
-          std::get<SpawnVehicleEntity>(functions_)(proto.spawn_vehicle_entity());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kSpawnPedestrianEntity:
-        *sim_response.mutable_spawn_pedestrian_entity() =
-          std::get<SpawnPedestrianEntity>(functions_)(proto.spawn_pedestrian_entity());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kSpawnMiscObjectEntity:
-        *sim_response.mutable_spawn_misc_object_entity() =
-          std::get<SpawnMiscObjectEntity>(functions_)(proto.spawn_misc_object_entity());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kDespawnEntity:
-        *sim_response.mutable_despawn_entity() =
-          std::get<DespawnEntity>(functions_)(proto.despawn_entity());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kUpdateEntityStatus:
-        *sim_response.mutable_update_entity_status() =
-          std::get<UpdateEntityStatus>(functions_)(proto.update_entity_status());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kAttachLidarSensor:
-        *sim_response.mutable_attach_lidar_sensor() =
-          std::get<AttachLidarSensor>(functions_)(proto.attach_lidar_sensor());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kAttachDetectionSensor:
-        *sim_response.mutable_attach_detection_sensor() =
-          std::get<AttachDetectionSensor>(functions_)(proto.attach_detection_sensor());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kAttachOccupancyGridSensor:
-        *sim_response.mutable_attach_occupancy_grid_sensor() =
-          std::get<AttachOccupancyGridSensor>(functions_)(proto.attach_occupancy_grid_sensor());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kUpdateTrafficLights:
-        *sim_response.mutable_update_traffic_lights() =
-          std::get<UpdateTrafficLights>(functions_)(proto.update_traffic_lights());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kFollowPolylineTrajectory:
-        *sim_response.mutable_follow_polyline_trajectory() =
-          std::get<FollowPolylineTrajectory>(functions_)(proto.follow_polyline_trajectory());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::REQUEST_NOT_SET: {
-        THROW_SIMULATION_ERROR("No case defined for oneof in SimulationRequest message");
+    receive();
+  }
+  return true;
+}
+
+void MultiServer::receive()
+{
+  zmqpp::message sim_request;
+  socket_.receive(sim_request);
+  if (sim_request.parts() < 2) {
+    THROW_SIMULATION_ERROR("SimulationRequest message should have a routing envelope.");
+  }
+  const auto received_time = statistics_ ? std::chrono::steady_clock::now()
+                                         : std::chrono::steady_clock::time_point();
+  auto job = std::make_unique<Job>();
+  const auto body = sim_request.parts() - 1;
+  for (std::size_t part = 0; part < body; ++part) {
+    job->envelope.add_raw(sim_request.raw_data(part), sim_request.size(part));
+  }
+  const auto is_shared_memory_frame =
+    simulation_interface::isSharedMemoryFrame(sim_request.raw_data(body), sim_request.size(body));
+  if (is_shared_memory_frame) {
+    std::memcpy(&job->frame, sim_request.raw_data(body), sizeof(job->frame));
+    if (job->frame.type == simulation_interface::SharedMemoryFrameType::OPEN) {
+      openSharedMemory(job->envelope, job->frame);
+      return;
+    }
+  }
+  if (pending_job_count_ == 0) {
+    arena_.Reset();
+  }
+  auto & proto =
+    *google::protobuf::Arena::CreateMessage<simulation_api_schema::SimulationRequest>(&arena_);
+  if (is_shared_memory_frame) {
+    job->shared_memory = &getSharedMemory(job->frame);
+    proto.ParseFromArray(
+      job->shared_memory->getRequestSlot(job->frame.slot), static_cast<int>(job->frame.size));
+    job->sample.request_bytes = job->frame.size;
+  } else {
+    parseFrame(sim_request, body, proto);
+    job->sample.request_bytes = sim_request.size(body);
+  }
+  if (statistics_) {
+    job->parsed_time = std::chrono::steady_clock::now();
+    job->sample.parse = job->parsed_time - received_time;
+  }
+  job->request_case = proto.request_case();
+  job->request = &proto;
+  if (not workers_.empty() and options_.concurrent_requests.count(job->request_case)) {
+    {
+      std::lock_guard<std::mutex> lock(job_mutex_);
+      jobs_.push_back(std::move(job));
+    }
+    ++pending_job_count_;
+    job_condition_.notify_one();
+  } else {
+    waitForJobs();
+    handle(*job);
+    send(*job);
+  }
+}
+
+void MultiServer::send(Job & job)
+{
+  const auto start_time =
+    statistics_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+  const auto size = job.response.ByteSizeLong();
+  if (job.shared_memory and size <= job.shared_memory->getSlotSize()) {
+    job.response.SerializeToArray(
+      job.shared_memory->getResponseSlot(job.frame.slot), static_cast<int>(size));
+    const auto frame =
+      simulation_interface::makeSharedMemoryFrame(*job.shared_memory, job.frame.slot, size);
+    job.envelope.add_raw(&frame, sizeof(frame));
+  } else {
+    addFrame(job.envelope, job.response);
+  }
+  if (statistics_) {
+    const auto serialized_time = std::chrono::steady_clock::now();
+    socket_.send(job.envelope);
+    job.sample.serialize = serialized_time - start_time;
+    job.sample.send = std::chrono::steady_clock::now() - serialized_time;
+    job.sample.response_bytes = size;
+    statistics_->record(job.request_case, job.sample);
+  } else {
+    socket_.send(job.envelope);
+  }
+}
+
+void MultiServer::sendCompletedJobs()
+{
+  std::uint64_t value;
+  [[maybe_unused]] const auto read_size = read(completion_event_, &value, sizeof(value));
+  std::deque<std::unique_ptr<Job>> completed_jobs;
+  {
+    std::lock_guard<std::mutex> lock(job_mutex_);
+    std::swap(completed_jobs, completed_jobs_);
+  }
+  for (auto && job : completed_jobs) {
+    --pending_job_count_;
+    if (job->thrown) {
+      std::rethrow_exception(job->thrown);
+    }
+    send(*job);
+  }
+}
+
+void MultiServer::waitForJobs()
+{
+  while (pending_job_count_ != 0) {
+    {
+      std::unique_lock<std::mutex> lock(job_mutex_);
+      completion_condition_.wait(lock, [this]() { return not completed_jobs_.empty(); });
+    }
+    sendCompletedJobs();
+  }
+}
+
+void MultiServer::work()
+{
+  while (true) {
+    std::unique_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(job_mutex_);
+      job_condition_.wait(lock, [this]() { return is_stop_requested_ or not jobs_.empty(); });
+      if (jobs_.empty()) {
+        return;
       }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    try {
+      handle(*job);
+    } catch (...) {
+      job->thrown = std::current_exception();
     }
-    auto msg = toZMQ(sim_response);
-    socket_.send(msg);
+    {
+      std::lock_guard<std::mutex> lock(job_mutex_);
+      completed_jobs_.push_back(std::move(job));
+    }
+    completion_condition_.notify_one();
+    const std::uint64_t value = 1;
+    [[maybe_unused]] const auto written = write(completion_event_, &value, sizeof(value));
   }
 }
 
@@ -90,7 +355,9 @@ void MultiServer::start_poll()
 {
   while (rclcpp::ok()) {
     common::status_monitor.touch(__func__);
-    poll();
+    if (not poll()) {
+      break;
+    }
   }
 }
 }  // namespace zeromq
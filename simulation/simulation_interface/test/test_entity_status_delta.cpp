@@ -0,0 +1,110 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <simulation_api_schema.pb.h>
+
+#include <cstddef>
+#include <iostream>
+#include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/entity_status_delta.hpp>
+#include <string>
+#include <vector>
+
+auto makeEntityStatuses(std::size_t count, std::size_t moving_count, double time)
+  -> std::vector<simulation_api_schema::EntityStatus>
+{
+  std::vector<simulation_api_schema::EntityStatus> statuses(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto & status = statuses[i];
+    status.set_name("entity" + std::to_string(i));
+    status.mutable_type()->set_type(traffic_simulator_msgs::EntityType::VEHICLE);
+    status.mutable_subtype()->set_value(traffic_simulator_msgs::EntitySubtype::CAR);
+    status.set_time(time);
+    status.mutable_action_status()->set_current_action("follow_lane");
+    status.mutable_pose()->mutable_position()->set_x(static_cast<double>(i) * 10.0);
+    status.mutable_pose()->mutable_orientation()->set_w(1.0);
+    if (i < moving_count) {
+      status.mutable_pose()->mutable_position()->set_x(static_cast<double>(i) * 10.0 + time);
+      status.mutable_action_status()->mutable_twist()->mutable_linear()->set_x(10.0);
+    }
+  }
+  return statuses;
+}
+
+void expectEqual(
+  const std::vector<simulation_api_schema::EntityStatus> & expected,
+  const std::vector<simulation_api_schema::EntityStatus> & actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i].SerializeAsString(), actual[i].SerializeAsString());
+  }
+}
+
+TEST(EntityStatusDelta, RoundTrip)
+{
+  simulation_interface::EntityStatusDeltaEncoder encoder(10);
+  simulation_interface::EntityStatusDeltaDecoder decoder;
+  for (int frame = 0; frame < 25; ++frame) {
+    const auto time = frame * 0.05;
+    auto statuses = makeEntityStatuses(20, 5, time);
+    if (frame == 12) {
+      statuses[3].mutable_action_status()->set_current_action("lane_change");
+      statuses[7].mutable_subtype()->set_value(traffic_simulator_msgs::EntitySubtype::TRUCK);
+    }
+    if (frame == 15) {
+      statuses.erase(statuses.begin() + 4);
+    }
+    expectEqual(statuses, decoder.decode(encoder.encode(statuses, time)));
+  }
+}
+
+TEST(EntityStatusDelta, SendOnlyChangedFields)
+{
+  simulation_interface::EntityStatusDeltaEncoder encoder(100);
+  const auto keyframe = encoder.encode(makeEntityStatuses(500, 50, 0.0), 0.0);
+  EXPECT_TRUE(keyframe.keyframe());
+  const auto frame = encoder.encode(makeEntityStatuses(500, 50, 0.05), 0.05);
+  EXPECT_FALSE(frame.keyframe());
+  ASSERT_EQ(frame.delta_size(), 500);
+  EXPECT_EQ(frame.delta(0).fields(), simulation_api_schema::EntityStatusDelta::POSITION);
+  EXPECT_EQ(frame.delta(499).fields(), simulation_api_schema::EntityStatusDelta::NONE);
+
+  simulation_api_schema::UpdateEntityStatusBatchRequest full;
+  for (const auto & status : makeEntityStatuses(500, 50, 0.05)) {
+    *full.add_status() = status;
+  }
+  std::cout << "full: " << full.ByteSizeLong() << " bytes, delta: " << frame.ByteSizeLong()
+            << " bytes for 500 entities of which 50 are moving" << std::endl;
+  EXPECT_LT(frame.ByteSizeLong() * 10, full.ByteSizeLong());
+}
+
+TEST(EntityStatusDelta, ResynchroniseOnKeyframe)
+{
+  simulation_interface::EntityStatusDeltaEncoder encoder(3);
+  simulation_interface::EntityStatusDeltaDecoder decoder;
+  decoder.decode(encoder.encode(makeEntityStatuses(3, 1, 0.0), 0.0));
+  const auto lost = encoder.encode(makeEntityStatuses(4, 1, 0.1), 0.1);
+  EXPECT_THROW(
+    decoder.decode(encoder.encode(makeEntityStatuses(4, 1, 0.2), 0.2)), common::SimulationError);
+  const auto statuses = makeEntityStatuses(4, 1, 0.3);
+  expectEqual(statuses, decoder.decode(encoder.encode(statuses, 0.3)));
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <google/protobuf/arena.h>
+#include <gtest/gtest.h>
+#include <simulation_api_schema.pb.h>
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <simulation_interface/conversions.hpp>
+#include <string>
+#include <vector>
+
+constexpr std::size_t entity_count = 500;
+
+constexpr int frame_count = 200;
+
+auto makeStepRequest() -> simulation_api_schema::SimulationRequest
+{
+  simulation_api_schema::SimulationRequest request;
+  auto & step = *request.mutable_step();
+  for (std::size_t i = 0; i < entity_count; ++i) {
+    auto & status = *step.mutable_entity_status()->add_status();
+    status.set_name("entity" + std::to_string(i));
+    status.set_time(1.0);
+    status.mutable_action_status()->set_current_action("follow_lane");
+    status.mutable_action_status()->mutable_twist()->mutable_linear()->set_x(10.0);
+    status.mutable_pose()->mutable_position()->set_x(static_cast<double>(i));
+    status.mutable_pose()->mutable_position()->set_y(static_cast<double>(i) * 0.5);
+    status.mutable_pose()->mutable_orientation()->set_w(1.0);
+  }
+  step.mutable_frame()->set_current_time(1.0);
+  return request;
+}
+
+/**
+ * @brief Print frames per second of function called frame_count times.
+ */
+template <typename Function>
+void printThroughput(const std::string & name, Function && function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < frame_count; ++i) {
+    function();
+  }
+  const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+  std::cout << name << ": " << frame_count / elapsed.count() << " frames/s with " << entity_count
+            << " entities" << std::endl;
+}
+
+TEST(Framing, RoundTrip)
+{
+  const auto request = makeStepRequest();
+  const auto message = zeromq::toZMQ(request);
+  EXPECT_EQ(message.parts(), 1U);
+  EXPECT_EQ(message.size(0), request.ByteSizeLong());
+  const auto parsed = zeromq::toProto<simulation_api_schema::SimulationRequest>(message);
+  EXPECT_EQ(parsed.SerializeAsString(), request.SerializeAsString());
+  EXPECT_EQ(parsed.step().entity_status().status_size(), static_cast<int>(entity_count));
+}
+
+TEST(Framing, Throughput)
+{
+  const auto request = makeStepRequest();
+
+  printThroughput("string framing", [&]() {
+    std::string serialized_str;
+    request.SerializeToString(&serialized_str);
+    zmqpp::message message;
+    message << serialized_str;
+    simulation_api_schema::SimulationRequest parsed;
+    parsed.ParseFromString(message.get(0));
+    EXPECT_EQ(parsed.step().entity_status().status_size(), static_cast<int>(entity_count));
+  });
+
+  printThroughput("zero-copy framing", [&]() {
+    zmqpp::message message;
+    zeromq::addFrame(message, request);
+    simulation_api_schema::SimulationRequest parsed;
+    zeromq::parseFrame(message, 0, parsed);
+    EXPECT_EQ(parsed.step().entity_status().status_size(), static_cast<int>(entity_count));
+  });
+
+  std::vector<char> initial_block(4 * 1024 * 1024);
+  google::protobuf::ArenaOptions options;
+  options.initial_block = initial_block.data();
+  options.initial_block_size = initial_block.size();
+  google::protobuf::Arena arena(options);
+  printThroughput("zero-copy framing with arena", [&]() {
+    zmqpp::message message;
+    zeromq::addFrame(message, request);
+    arena.Reset();
+    auto & parsed =
+      *google::protobuf::Arena::CreateMessage<simulation_api_schema::SimulationRequest>(&arena);
+    zeromq::parseFrame(message, 0, parsed);
+    EXPECT_EQ(parsed.step().entity_status().status_size(), static_cast<int>(entity_count));
+  });
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,80 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <simulation_interface/rpc_statistics.hpp>
+
+TEST(LatencyHistogram, Percentiles)
+{
+  simulation_interface::LatencyHistogram histogram;
+  EXPECT_EQ(histogram.getPercentile(0.5), std::chrono::nanoseconds(0));
+  for (std::int64_t i = 1; i <= 1000; ++i) {
+    histogram.record(std::chrono::microseconds(i));
+  }
+  EXPECT_EQ(histogram.getCount(), 1000U);
+  EXPECT_EQ(histogram.getMax(), std::chrono::microseconds(1000));
+  EXPECT_EQ(histogram.getMean(), std::chrono::nanoseconds(500500));
+  for (const auto quantile : {0.01, 0.5, 0.9, 0.99}) {
+    const auto expected = quantile * 1000000.0;
+    const auto actual = static_cast<double>(histogram.getPercentile(quantile).count());
+    EXPECT_GE(actual, expected);
+    EXPECT_LE(actual, expected * (1.0 + 1.0 / 32.0));
+  }
+  EXPECT_EQ(histogram.getPercentile(1.0), std::chrono::microseconds(1000));
+}
+
+TEST(LatencyHistogram, ExactForSmallDurations)
+{
+  simulation_interface::LatencyHistogram histogram;
+  for (std::int64_t i = 0; i < 64; ++i) {
+    histogram.record(std::chrono::nanoseconds(i));
+  }
+  EXPECT_EQ(histogram.getPercentile(0.5), std::chrono::nanoseconds(31));
+}
+
+TEST(RpcStatistics, RecordOnlyMeasuredPhases)
+{
+  simulation_interface::RpcStatisticsRecorder recorder;
+  simulation_interface::RpcSample sample;
+  sample.handle = std::chrono::milliseconds(3);
+  sample.request_bytes = 100;
+  sample.response_bytes = 20;
+  recorder.record(simulation_api_schema::SimulationRequest::RequestCase::kStep, sample);
+  recorder.record(simulation_api_schema::SimulationRequest::RequestCase::kStep, sample);
+
+  const auto statistics = recorder.getStatistics();
+  ASSERT_EQ(statistics.count("step"), 1U);
+  EXPECT_EQ(statistics.at("step").count, 2U);
+  EXPECT_EQ(statistics.at("step").request_bytes, 200U);
+  EXPECT_EQ(statistics.at("step").handle.getCount(), 2U);
+  EXPECT_EQ(statistics.at("step").wait.getCount(), 0U);
+
+  const auto json = simulation_interface::toJson(statistics);
+  EXPECT_EQ(json["step"]["response_bytes"], 40U);
+  EXPECT_EQ(json["step"]["handle"]["max_ns"], 3000000);
+  EXPECT_FALSE(json["step"].contains("wait"));
+
+  const auto statuses = simulation_interface::toDiagnosticStatuses("client", statistics);
+  ASSERT_EQ(statuses.size(), 1U);
+  EXPECT_EQ(statuses[0].name, "client: step");
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
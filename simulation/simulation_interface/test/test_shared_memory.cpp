@@ -0,0 +1,75 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <simulation_api_schema.pb.h>
+
+#include <cstring>
+#include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/shared_memory.hpp>
+#include <string>
+
+TEST(SharedMemory, OpenSegmentCreatedByOther)
+{
+  const auto name = simulation_interface::makeSharedMemorySegmentName();
+  simulation_interface::SharedMemorySegment created(name, 4, 1024);
+  simulation_interface::SharedMemorySegment opened(name);
+  EXPECT_EQ(opened.getSlotCount(), 4U);
+  EXPECT_EQ(opened.getSlotSize(), 1024U);
+
+  simulation_api_schema::SimulationRequest request;
+  request.mutable_update_frame()->set_current_time(1.5);
+  const auto size = request.ByteSizeLong();
+  request.SerializeToArray(created.getRequestSlot(3), static_cast<int>(size));
+  simulation_api_schema::SimulationRequest received;
+  EXPECT_TRUE(received.ParseFromArray(opened.getRequestSlot(3), static_cast<int>(size)));
+  EXPECT_DOUBLE_EQ(received.update_frame().current_time(), 1.5);
+
+  std::strcpy(reinterpret_cast<char *>(opened.getResponseSlot(3)), "response");
+  EXPECT_STREQ(reinterpret_cast<const char *>(created.getResponseSlot(3)), "response");
+  EXPECT_STRNE(reinterpret_cast<const char *>(created.getRequestSlot(3)), "response");
+}
+
+TEST(SharedMemory, UnlinkSegmentWithOwner)
+{
+  const auto name = simulation_interface::makeSharedMemorySegmentName();
+  {
+    simulation_interface::SharedMemorySegment created(name, 1, 16);
+  }
+  EXPECT_THROW(simulation_interface::SharedMemorySegment opened(name), common::SimulationError);
+}
+
+TEST(SharedMemory, TellFramesFromSerializedMessages)
+{
+  simulation_interface::SharedMemorySegment segment(
+    simulation_interface::makeSharedMemorySegmentName(), 1, 16);
+  const auto frame = simulation_interface::makeSharedMemoryFrame(segment, 0, 8);
+  EXPECT_TRUE(simulation_interface::isSharedMemoryFrame(&frame, sizeof(frame)));
+  EXPECT_EQ(std::string(frame.segment_name), segment.getName());
+
+  simulation_api_schema::SimulationRequest request;
+  auto & status = *request.mutable_update_entity_status()->mutable_status();
+  status.set_name(std::string(sizeof(frame), 'a'));
+  std::string serialized_str;
+  request.SerializeToString(&serialized_str);
+  serialized_str.resize(sizeof(frame));
+  EXPECT_FALSE(
+    simulation_interface::isSharedMemoryFrame(serialized_str.data(), serialized_str.size()));
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,191 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <simulation_api_schema.pb.h>
+
+#include <cstddef>
+#include <cstring>
+#include <future>
+#include <simulation_interface/shared_memory.hpp>
+#include <simulation_interface/zmq_multi_client.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zmqpp/zmqpp.hpp>
+
+/**
+ * @brief Answer a request received by a ROUTER socket the same way zeromq::MultiServer does.
+ */
+void reply(
+  zmqpp::socket & socket, const zmqpp::message & request,
+  const simulation_interface::SharedMemorySegment * shared_memory = nullptr)
+{
+  const auto body = request.parts() - 1;
+  simulation_api_schema::SimulationRequest proto;
+  if (shared_memory) {
+    simulation_interface::SharedMemoryFrame frame;
+    std::memcpy(&frame, request.raw_data(body), sizeof(frame));
+    proto.ParseFromArray(shared_memory->getRequestSlot(frame.slot), static_cast<int>(frame.size));
+  } else {
+    proto.ParseFromArray(request.raw_data(body), static_cast<int>(request.size(body)));
+  }
+  simulation_api_schema::SimulationResponse response;
+  response.mutable_step()->mutable_result()->set_success(true);
+  response.mutable_step()->mutable_result()->set_description(
+    std::to_string(proto.step().frame().current_time()));
+  zmqpp::message message;
+  for (std::size_t part = 0; part < body; ++part) {
+    message.add_raw(request.raw_data(part), request.size(part));
+  }
+  std::string serialized_str;
+  response.SerializeToString(&serialized_str);
+  message << serialized_str;
+  socket.send(message);
+}
+
+/**
+ * @brief Bind a ROUTER socket to a port chosen by the system and return that port.
+ * @note Test processes may run in parallel, so no port is hard-coded.
+ */
+auto bindToFreePort(zmqpp::socket & socket) -> unsigned int
+{
+  socket.bind(simulation_interface::getEndPoint(
+    simulation_interface::TransportProtocol::TCP, simulation_interface::HostName::ANY, 0));
+  std::string endpoint;
+  socket.get(zmqpp::socket_option::last_endpoint, endpoint);
+  return std::stoul(endpoint.substr(endpoint.rfind(':') + 1));
+}
+
+auto makeStepRequest(double current_time) -> simulation_api_schema::StepRequest
+{
+  simulation_api_schema::StepRequest request;
+  request.mutable_frame()->set_current_time(current_time);
+  return request;
+}
+
+TEST(MultiClient, MatchResponsesAnsweredOutOfOrder)
+{
+  zmqpp::context context;
+  zmqpp::socket server(context, zmqpp::socket_type::router);
+  const auto port = bindToFreePort(server);
+  zeromq::MultiClient client(simulation_interface::TransportProtocol::TCP, "localhost", port, 4);
+
+  std::vector<std::future<simulation_api_schema::StepResponse>> responses;
+  for (int i = 0; i < 4; ++i) {
+    responses.push_back(client.callAsync(makeStepRequest(i)));
+  }
+  std::vector<zmqpp::message> requests(4);
+  for (auto & request : requests) {
+    server.receive(request);
+  }
+  for (auto request = requests.rbegin(); request != requests.rend(); ++request) {
+    reply(server, *request);
+  }
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(responses[i].get().result().description(), std::to_string(static_cast<double>(i)));
+  }
+}
+
+TEST(MultiClient, BoundInFlightRequests)
+{
+  constexpr int request_count = 16;
+  zmqpp::context context;
+  zmqpp::socket server(context, zmqpp::socket_type::router);
+  const auto port = bindToFreePort(server);
+  auto server_thread = std::thread([&]() {
+    for (int i = 0; i < request_count; ++i) {
+      zmqpp::message request;
+      server.receive(request);
+      reply(server, request);
+    }
+  });
+  zeromq::MultiClient client(simulation_interface::TransportProtocol::TCP, "localhost", port, 2);
+
+  std::vector<std::future<simulation_api_schema::StepResponse>> responses;
+  for (int i = 0; i < request_count / 2; ++i) {
+    responses.push_back(client.callAsync(makeStepRequest(i)));
+  }
+  for (int i = request_count / 2; i < request_count; ++i) {
+    EXPECT_EQ(
+      client.call(makeStepRequest(i)).result().description(),
+      std::to_string(static_cast<double>(i)));
+  }
+  for (int i = 0; i < request_count / 2; ++i) {
+    EXPECT_EQ(responses[i].get().result().description(), std::to_string(static_cast<double>(i)));
+  }
+  server_thread.join();
+}
+
+TEST(MultiClient, TakeFreeSharedMemorySlots)
+{
+  zmqpp::context context;
+  zmqpp::socket server(context, zmqpp::socket_type::router);
+  const auto port = bindToFreePort(server);
+  std::vector<simulation_interface::SharedMemoryFrame> frames(5);
+  auto server_thread = std::thread([&]() {
+    zmqpp::message open;
+    server.receive(open);
+    auto frame = simulation_interface::SharedMemoryFrame();
+    std::memcpy(&frame, open.raw_data(3), sizeof(frame));
+    const auto shared_memory = simulation_interface::SharedMemorySegment(
+      std::string(frame.segment_name, strnlen(frame.segment_name, sizeof(frame.segment_name))));
+    zmqpp::message opened;
+    for (std::size_t part = 0; part < 3; ++part) {
+      opened.add_raw(open.raw_data(part), open.size(part));
+    }
+    frame.type = simulation_interface::SharedMemoryFrameType::OPENED;
+    opened.add_raw(&frame, sizeof(frame));
+    server.send(opened);
+    std::vector<zmqpp::message> requests(5);
+    for (std::size_t i = 0; i < 4; ++i) {
+      server.receive(requests[i]);
+    }
+    /// @note Answer the second request only, so the fifth one is sent while the others are pending.
+    reply(server, requests[1], &shared_memory);
+    server.receive(requests[4]);
+    for (std::size_t i = 0; i < 5; ++i) {
+      std::memcpy(&frames[i], requests[i].raw_data(3), sizeof(frames[i]));
+      if (i != 1) {
+        reply(server, requests[i], &shared_memory);
+      }
+    }
+  });
+  zeromq::MultiClient client(
+    simulation_interface::TransportProtocol::SHARED_MEMORY, "localhost", port, 4);
+
+  std::vector<std::future<simulation_api_schema::StepResponse>> responses;
+  for (int i = 0; i < 5; ++i) {
+    responses.push_back(client.callAsync(makeStepRequest(i)));
+  }
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(responses[i].get().result().description(), std::to_string(static_cast<double>(i)));
+  }
+  server_thread.join();
+  for (std::size_t i = 0; i < 5; ++i) {
+    ASSERT_EQ(frames[i].type, simulation_interface::SharedMemoryFrameType::BODY);
+    for (std::size_t j = 0; j < i; ++j) {
+      /// @note Only the slot of the answered request may be taken again.
+      if (i != 4 or j != 1) {
+        EXPECT_NE(frames[i].slot, frames[j].slot);
+      }
+    }
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
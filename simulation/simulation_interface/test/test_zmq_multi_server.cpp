@@ -0,0 +1,192 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <simulation_api_schema.pb.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <rclcpp/rclcpp.hpp>
+#include <simulation_interface/shared_memory.hpp>
+#include <simulation_interface/zmq_multi_client.hpp>
+#include <simulation_interface/zmq_multi_server.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zmqpp/zmqpp.hpp>
+
+template <typename Response>
+auto respond()
+{
+  return [](const auto &) {
+    auto response = Response();
+    response.mutable_result()->set_success(true);
+    return response;
+  };
+}
+
+auto makeServer(
+  unsigned int port, const zeromq::MultiServer::Options & options,
+  simulation_interface::TransportProtocol protocol = simulation_interface::TransportProtocol::TCP)
+{
+  return std::make_unique<zeromq::MultiServer>(
+    protocol, simulation_interface::HostName::ANY, port, options,
+    respond<simulation_api_schema::InitializeResponse>(),
+    respond<simulation_api_schema::UpdateFrameResponse>(),
+    respond<simulation_api_schema::SpawnVehicleEntityResponse>(),
+    respond<simulation_api_schema::SpawnPedestrianEntityResponse>(),
+    respond<simulation_api_schema::SpawnMiscObjectEntityResponse>(),
+    respond<simulation_api_schema::DespawnEntityResponse>(),
+    [](const simulation_api_schema::UpdateEntityStatusRequest & request) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      auto response = simulation_api_schema::UpdateEntityStatusResponse();
+      response.mutable_result()->set_success(true);
+      response.mutable_status()->set_name(request.status().name());
+      return response;
+    },
+    respond<simulation_api_schema::AttachLidarSensorResponse>(),
+    respond<simulation_api_schema::AttachDetectionSensorResponse>(),
+    respond<simulation_api_schema::AttachOccupancyGridSensorResponse>(),
+    respond<simulation_api_schema::UpdateTrafficLightsResponse>(),
+    respond<simulation_api_schema::FollowPolylineTrajectoryResponse>(),
+    respond<simulation_api_schema::UpdateEntityStatusBatchResponse>(),
+    respond<simulation_api_schema::StepResponse>());
+}
+
+auto makeUpdateEntityStatusRequest(const std::string & name)
+{
+  simulation_api_schema::SimulationRequest request;
+  request.mutable_update_entity_status()->mutable_status()->set_name(name);
+  return request;
+}
+
+TEST(MultiServer, HandleConcurrentRequestsOnWorkers)
+{
+  constexpr unsigned int port = 18767;
+  auto options = zeromq::MultiServer::Options();
+  options.concurrent_requests = {
+    simulation_api_schema::SimulationRequest::RequestCase::kUpdateEntityStatus};
+  options.worker_count = 4;
+  options.record_statistics = true;
+  auto server = makeServer(port, options);
+  zeromq::MultiClient client(
+    simulation_interface::TransportProtocol::TCP, "localhost", port, 8, true);
+
+  std::vector<std::future<simulation_api_schema::SimulationResponse>> responses;
+  for (int i = 0; i < 8; ++i) {
+    responses.push_back(client.callAsync(makeUpdateEntityStatusRequest(std::to_string(i))));
+  }
+  EXPECT_TRUE(client.call(simulation_api_schema::UpdateFrameRequest()).result().success());
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(responses[i].get().update_entity_status().status().name(), std::to_string(i));
+  }
+  /// @note The server records a request after sending its response, so the update_frame request
+  /// is recorded once the response to a later request is received.
+  EXPECT_TRUE(client.call(simulation_api_schema::InitializeRequest()).result().success());
+
+  const auto server_statistics = server->getStatistics();
+  EXPECT_EQ(server_statistics.at("update_entity_status").count, 8U);
+  EXPECT_EQ(server_statistics.at("update_entity_status").handle.getCount(), 8U);
+  EXPECT_GE(
+    server_statistics.at("update_entity_status").handle.getMax(), std::chrono::milliseconds(10));
+  EXPECT_EQ(server_statistics.at("update_frame").count, 1U);
+
+  const auto client_statistics = client.getStatistics();
+  EXPECT_EQ(client_statistics.at("update_entity_status").count, 8U);
+  EXPECT_GE(
+    client_statistics.at("update_entity_status").wait.getMax(), std::chrono::milliseconds(10));
+  EXPECT_EQ(client_statistics.at("update_entity_status").handle.getCount(), 0U);
+  EXPECT_EQ(
+    client_statistics.at("update_frame").request_bytes,
+    server_statistics.at("update_frame").request_bytes);
+}
+
+TEST(MultiServer, StopWithoutWaitingForRequests)
+{
+  constexpr unsigned int port = 18768;
+  const auto start = std::chrono::steady_clock::now();
+  makeServer(port, zeromq::MultiServer::Options()).reset();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+}
+
+TEST(MultiServer, RoundTripThroughSharedMemory)
+{
+  constexpr unsigned int port = 18769;
+  auto options = zeromq::MultiServer::Options();
+  options.concurrent_requests = {
+    simulation_api_schema::SimulationRequest::RequestCase::kUpdateEntityStatus};
+  options.worker_count = 4;
+  auto server = makeServer(port, options, simulation_interface::TransportProtocol::SHARED_MEMORY);
+  zeromq::MultiClient client(
+    simulation_interface::TransportProtocol::SHARED_MEMORY, "localhost", port, 4);
+
+  /// @note Twice as many requests as slots, answered by workers in any order, so slots are reused.
+  std::vector<std::future<simulation_api_schema::SimulationResponse>> responses;
+  for (int i = 0; i < 8; ++i) {
+    responses.push_back(client.callAsync(makeUpdateEntityStatusRequest(std::to_string(i))));
+  }
+  EXPECT_TRUE(client.call(simulation_api_schema::UpdateFrameRequest()).result().success());
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(responses[i].get().update_entity_status().status().name(), std::to_string(i));
+  }
+}
+
+TEST(MultiServer, AnswerSharedMemoryThatCannotBeOpened)
+{
+  constexpr unsigned int port = 18770;
+  auto server = makeServer(port, zeromq::MultiServer::Options());
+  zmqpp::context context;
+  zmqpp::socket client(context, zmqpp::socket_type::dealer);
+  client.connect(simulation_interface::getEndPoint(
+    simulation_interface::TransportProtocol::TCP, "localhost", port));
+
+  simulation_interface::SharedMemoryFrame frame;
+  frame.type = simulation_interface::SharedMemoryFrameType::OPEN;
+  std::strncpy(frame.segment_name, "/simulation_interface_missing", sizeof(frame.segment_name) - 1);
+  zmqpp::message request;
+  request << "" << std::uint64_t(0);
+  request.add_raw(&frame, sizeof(frame));
+  client.send(request);
+  zmqpp::message answer;
+  client.receive(answer);
+  ASSERT_EQ(answer.parts(), 3U);
+  ASSERT_TRUE(simulation_interface::isSharedMemoryFrame(answer.raw_data(2), answer.size(2)));
+  std::memcpy(&frame, answer.raw_data(2), sizeof(frame));
+  EXPECT_EQ(frame.type, simulation_interface::SharedMemoryFrameType::OPEN_FAILED);
+
+  /// @note The server keeps serving requests sent in the messages themselves.
+  simulation_api_schema::SimulationRequest update_frame;
+  update_frame.mutable_update_frame();
+  std::string serialized_str;
+  update_frame.SerializeToString(&serialized_str);
+  request = zmqpp::message();
+  request << "" << std::uint64_t(1) << serialized_str;
+  client.send(request);
+  client.receive(answer);
+  ASSERT_EQ(answer.parts(), 3U);
+  simulation_api_schema::SimulationResponse response;
+  response.ParseFromArray(answer.raw_data(2), static_cast<int>(answer.size(2)));
+  EXPECT_TRUE(response.update_frame().result().success());
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  const auto result = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return result;
+}
@@ -21,11 +21,15 @@
 #include <autoware_auto_vehicle_msgs/msg/vehicle_state_command.hpp>
 #include <boost/variant.hpp>
 #include <cassert>
+#include <chrono>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <future>
 #include <memory>
 #include <optional>
 #include <rclcpp/rclcpp.hpp>
 #include <rosgraph_msgs/msg/clock.hpp>
 #include <simulation_interface/conversions.hpp>
+#include <simulation_interface/entity_status_delta.hpp>
 #include <simulation_interface/zmq_multi_client.hpp>
 #include <stdexcept>
 #include <string>
@@ -76,8 +80,11 @@ public:
       rclcpp::PublisherOptionsWithAllocator<AllocatorT>())),
     debug_marker_pub_(rclcpp::create_publisher<visualization_msgs::msg::MarkerArray>(
       node, "debug_marker", rclcpp::QoS(100), rclcpp::PublisherOptionsWithAllocator<AllocatorT>())),
+    diagnostics_pub_(rclcpp::create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
+      node, "/diagnostics", rclcpp::QoS(10), rclcpp::PublisherOptionsWithAllocator<AllocatorT>())),
     zeromq_client_(
-      simulation_interface::protocol, configuration.simulator_host, getZMQSocketPort(*node))
+      configuration.transport_protocol, configuration.simulator_host, getZMQSocketPort(*node), 4,
+      configuration.record_rpc_statistics)
   {
     setVerbose(configuration.verbose);
   }
@@ -89,7 +96,7 @@ public:
     return node.get_parameter("port").as_int();
   }
 
-  void closeZMQConnection() { zeromq_client_.closeConnection(); }
+  void closeZMQConnection();
 
   void setVerbose(const bool verbose);
 
@@ -277,6 +284,7 @@ public:
   FORWARD_TO_ENTITY_MANAGER(getBehaviorParameter);
   FORWARD_TO_ENTITY_MANAGER(getBoundingBox);
   FORWARD_TO_ENTITY_MANAGER(getBoundingBoxDistance);
+  FORWARD_TO_ENTITY_MANAGER(getCollidingPairs);
   FORWARD_TO_ENTITY_MANAGER(getCurrentAccel);
   FORWARD_TO_ENTITY_MANAGER(getCurrentAction);
   FORWARD_TO_ENTITY_MANAGER(getCurrentTwist);
@@ -299,6 +307,7 @@ public:
   FORWARD_TO_ENTITY_MANAGER(getV2ITrafficLight);
   FORWARD_TO_ENTITY_MANAGER(getV2ITrafficLights);
   FORWARD_TO_ENTITY_MANAGER(getTraveledDistance);
+  FORWARD_TO_ENTITY_MANAGER(isColliding);
   FORWARD_TO_ENTITY_MANAGER(isEgoSpawned);
   FORWARD_TO_ENTITY_MANAGER(isInLanelet);
   FORWARD_TO_ENTITY_MANAGER(isNpcLogicStarted);
@@ -335,6 +344,22 @@ private:
   std::optional<CanonicalizedEntityStatus> updateEntityStatusInSim(
     const std::string & entity_name, const CanonicalizedEntityStatus & status);
   bool updateTrafficLightsInSim();
+  bool stepInSim();
+  bool waitForStepInSim();
+  void updateEgoEntityStatusInSim();
+  void publishRpcStatistics();
+
+  auto makeStepRequest() -> simulation_api_schema::StepRequest;
+  bool applyStepResponse(const simulation_api_schema::StepResponse &, bool npc_logic_started);
+
+  auto makeUpdateEntityStatusBatchRequest()
+    -> simulation_api_schema::UpdateEntityStatusBatchRequest;
+  auto makeUpdateTrafficLightsRequest() const -> simulation_api_schema::UpdateTrafficLightsRequest;
+  auto makeUpdateFrameRequest() const -> simulation_api_schema::UpdateFrameRequest;
+  auto applyUpdatedEntityStatus(
+    const std::string & entity_name, const CanonicalizedEntityStatus & status,
+    const simulation_api_schema::UpdatedEntityStatus & updated_status) const
+    -> CanonicalizedEntityStatus;
 
   const Configuration configuration;
 
@@ -346,9 +371,29 @@ private:
 
   const rclcpp::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr debug_marker_pub_;
 
+  const rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnostics_pub_;
+
+  /// @note Wall time when the RPC statistics were last published on /diagnostics.
+  std::chrono::steady_clock::time_point rpc_statistics_published_time_;
+
   traffic_simulator::SimulationClock clock_;
 
   zeromq::MultiClient zeromq_client_;
+
+  /// @note Encoder of the NPC statuses, only when configuration.delta_encode_entity_status is true.
+  simulation_interface::EntityStatusDeltaEncoder entity_status_encoder_;
+
+  /// @note Ego status of the next frame returned by the last StepRequest.
+  std::optional<simulation_api_schema::UpdatedEntityStatus> next_ego_status_;
+
+  /// @note npc_logic_started of the StepRequest which returned next_ego_status_.
+  bool next_ego_status_npc_logic_started_ = false;
+
+  /// @note StepRequest in flight, only when configuration.overlap_step_in_sim is true.
+  std::future<simulation_api_schema::StepResponse> pending_step_;
+
+  /// @note npc_logic_started of pending_step_.
+  bool pending_step_npc_logic_started_ = false;
 };
 }  // namespace traffic_simulator
 
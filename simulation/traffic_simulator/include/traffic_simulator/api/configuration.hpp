@@ -20,8 +20,10 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/range/iterator_range.hpp>
+#include <cstddef>
 #include <iomanip>
 #include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/constants.hpp>
 #include <string>
 
 namespace traffic_simulator
@@ -42,10 +44,97 @@ struct Configuration
 
   std::string simulator_host = "localhost";
 
+  /* ---- NOTE -----------------------------------------------------------------
+   *
+   *  TransportProtocol::SHARED_MEMORY passes requests and responses through
+   *  shared memory instead of copying them into socket messages. It needs a
+   *  simulator built with the shared memory support of simulation_interface,
+   *  and falls back to TCP if simulator_host is not localhost.
+   *
+   *  Either protocol uses the framing of zeromq::MultiClient, documented on
+   *  SimulationRequest in simulation_api_schema.proto. Simulators replying on
+   *  a REP socket must be updated to it, even when they stay on TCP.
+   *
+   * ------------------------------------------------------------------------ */
+  simulation_interface::TransportProtocol transport_protocol = simulation_interface::protocol;
+
   double conventional_traffic_light_publish_rate = 30.0;
 
   double v2i_traffic_light_publish_rate = 10.0;
 
+  /* ---- NOTE -----------------------------------------------------------------
+   *
+   *  Number of threads updating the NPC logic in EntityManager::update,
+   *  including the calling thread. 0 or 1 updates the NPCs serially. Each NPC
+   *  only reads the statuses of the previous frame, so the result does not
+   *  depend on this value.
+   *
+   * ------------------------------------------------------------------------ */
+  std::size_t npc_logic_thread_count = 0;
+
+  /* ---- NOTE -----------------------------------------------------------------
+   *
+   *  If true, the statuses of all NPCs are sent to the sensor/dynamics
+   *  simulator with one UpdateEntityStatusBatchRequest per frame instead of
+   *  one UpdateEntityStatusRequest per NPC. Set false to connect to a
+   *  simulator which does not support UpdateEntityStatusBatchRequest.
+   *
+   * ------------------------------------------------------------------------ */
+  bool update_entity_status_in_batch = true;
+
+  /* ---- NOTE -----------------------------------------------------------------
+   *
+   *  If true, each frame is sent to the sensor/dynamics simulator as one
+   *  StepRequest carrying the NPC statuses, the traffic lights and the clock,
+   *  and its response carries the ego status of the next frame, so a frame
+   *  costs one round trip. Set false to connect to a simulator which does not
+   *  support StepRequest.
+   *
+   *  The ego entity of frame k + 1 is advanced when the StepRequest of frame k
+   *  is handled, so the control commands of Autoware are sampled at the end of
+   *  frame k instead of at the start of frame k + 1. Commands published while
+   *  the NPC logic of frame k + 1 runs take effect one frame later than with
+   *  the per-call protocol.
+   *
+   * ------------------------------------------------------------------------ */
+  bool step_in_single_request = true;
+
+  /* ---- NOTE -----------------------------------------------------------------
+   *
+   *  If true (and step_in_single_request is true), updateFrame returns as
+   *  soon as the StepRequest is sent, and waits for its response in the next
+   *  updateFrame after the NPC logic of the next frame, so the sensor
+   *  simulator renders frame k while the NPCs of frame k+1 are computed. In
+   *  exchange, NPCs see the ego entity one frame late, and a failure of a step
+   *  is reported by the next updateFrame.
+   *
+   * ------------------------------------------------------------------------ */
+  bool overlap_step_in_sim = false;
+
+  /* ---- NOTE -----------------------------------------------------------------
+   *
+   *  If true, the NPC statuses sent to the sensor/dynamics simulator each
+   *  frame are delta-encoded: the name and type of an NPC are sent once, and
+   *  afterwards only the fields which changed since the previous frame, with a
+   *  full keyframe every 100 frames. Set false to connect to a simulator which
+   *  does not support EntityStatusDeltaFrame.
+   *
+   * ------------------------------------------------------------------------ */
+  bool delta_encode_entity_status = true;
+
+  /* ---- NOTE -----------------------------------------------------------------
+   *
+   *  If true, the serialization, sending, waiting and parsing time and the
+   *  message sizes of the requests to the sensor/dynamics simulator are
+   *  recorded by request type, published on /diagnostics every second, and
+   *  written as JSON to rpc_statistics_file (unless empty) when the connection
+   *  is closed. If false, requests are not timed at all.
+   *
+   * ------------------------------------------------------------------------ */
+  bool record_rpc_statistics = false;
+
+  std::string rpc_statistics_file = "";
+
   /* ---- NOTE -----------------------------------------------------------------
    *
    *  This setting comes from the argument of the same name (= `map_path`) in
@@ -0,0 +1,53 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__BEHAVIOR__BEHAVIOR_PLUGIN_LOADER_HPP_
+#define TRAFFIC_SIMULATOR__BEHAVIOR__BEHAVIOR_PLUGIN_LOADER_HPP_
+
+#include <memory>
+#include <mutex>
+#include <pluginlib/class_loader.hpp>
+#include <string>
+#include <traffic_simulator/behavior/behavior_plugin_base.hpp>
+
+namespace entity_behavior
+{
+/**
+ * @brief Process-wide loader of behavior plugins shared by all entities.
+ * @note The plugin manifests are scanned once when the loader is created, and each plugin library
+ * is loaded once on its first use and kept loaded, so spawning an entity only creates an instance.
+ * Entities hold the loader by std::shared_ptr, so it outlives every plugin instance it created.
+ */
+class BehaviorPluginLoader
+{
+public:
+  static auto get() -> std::shared_ptr<BehaviorPluginLoader>;
+
+  auto createSharedInstance(const std::string & plugin_name) -> std::shared_ptr<BehaviorPluginBase>;
+
+  BehaviorPluginLoader(const BehaviorPluginLoader &) = delete;
+
+  BehaviorPluginLoader & operator=(const BehaviorPluginLoader &) = delete;
+
+private:
+  BehaviorPluginLoader();
+
+  /// @note pluginlib::ClassLoader is not safe to call concurrently.
+  std::mutex mutex_;
+
+  pluginlib::ClassLoader<BehaviorPluginBase> loader_;
+};
+}  // namespace entity_behavior
+
+#endif  // TRAFFIC_SIMULATOR__BEHAVIOR__BEHAVIOR_PLUGIN_LOADER_HPP_
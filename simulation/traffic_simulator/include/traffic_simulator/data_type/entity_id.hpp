@@ -0,0 +1,31 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__DATA_TYPE__ENTITY_ID_HPP_
+#define TRAFFIC_SIMULATOR__DATA_TYPE__ENTITY_ID_HPP_
+
+#include <cstddef>
+
+namespace traffic_simulator
+{
+/**
+ * @brief Handle of an entity, allocated by EntityManager when the entity is spawned.
+ * @note Handles are dense indices. Despawning an entity frees its id, and the next spawned entity
+ * takes it over, so an id refers to the same entity only while that entity is spawned. Entity
+ * names are only resolved to ids at the API boundary.
+ */
+using EntityId = std::size_t;
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__DATA_TYPE__ENTITY_ID_HPP_
@@ -0,0 +1,208 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__DATA_TYPE__WORLD_SNAPSHOT_HPP_
+#define TRAFFIC_SIMULATOR__DATA_TYPE__WORLD_SNAPSHOT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <geometry_msgs/msg/point.hpp>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <traffic_simulator/data_type/entity_id.hpp>
+#include <traffic_simulator/data_type/entity_status.hpp>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace traffic_simulator
+{
+/**
+ * @brief Statuses of all entities at one point of a frame.
+ * @note Built once by EntityManager and shared read-only (as std::shared_ptr<const WorldSnapshot>)
+ * by all entities and behavior trees instead of each of them copying the statuses.
+ * Entities are indexed by the EntityId that EntityManager allocated for them, so an id taken from a
+ * snapshot can be passed back to EntityManager, and ids of despawned entities are simply absent.
+ * Entities are also bucketed by lanelet and by a uniform grid on emplace, so that neighbour queries
+ * cost proportional to the number of nearby entities, not to the number of all entities.
+ */
+class WorldSnapshot
+{
+public:
+  auto emplace(EntityId id, const std::string & name, const CanonicalizedEntityStatus & status)
+    -> void;
+
+  auto size() const noexcept -> std::size_t { return ids_.size(); }
+
+  auto contains(EntityId id) const noexcept -> bool
+  {
+    return id < statuses_.size() and statuses_[id].has_value();
+  }
+
+  /**
+   * @brief Ids of all entities, in ascending order.
+   */
+  auto getIds() const noexcept -> const std::vector<EntityId> & { return ids_; }
+
+  auto getName(EntityId id) const -> const std::string &;
+
+  auto getStatus(EntityId id) const -> const CanonicalizedEntityStatus &;
+
+  auto findId(const std::string & name) const -> std::optional<EntityId>;
+
+  /**
+   * @brief Ids of the entities matched to the lanelet, in ascending order.
+   */
+  auto getIdsOnLanelet(std::int64_t lanelet_id) const -> const std::vector<EntityId> &;
+
+  /**
+   * @brief Ids of the entities whose bounding box may be within distance from the point in 2D,
+   * in ascending order.
+   * @note Bounding boxes are approximated by their circumscribed circles, so the result may contain
+   * entities slightly farther than distance but never misses a closer one.
+   */
+  auto getIdsWithin(const geometry_msgs::msg::Point & point, double distance) const
+    -> std::vector<EntityId>;
+
+  static constexpr double grid_cell_size = 50.0;
+
+private:
+  static auto getCellIndex(double coordinate) -> std::int64_t;
+
+  static auto getCellKey(std::int64_t x_index, std::int64_t y_index) -> std::uint64_t;
+
+  std::vector<EntityId> ids_;
+
+  /// @note Indexed by EntityId. Slots of ids which are not in the snapshot are empty.
+  std::vector<std::string> names_;
+
+  std::vector<std::optional<CanonicalizedEntityStatus>> statuses_;
+
+  std::unordered_map<std::string, EntityId> ids_by_name_;
+
+  std::unordered_map<std::int64_t, std::vector<EntityId>> lanelet_buckets_;
+
+  std::unordered_map<std::uint64_t, std::vector<EntityId>> grid_cells_;
+
+  /// @note Radius of the circumscribed circle of the bounding box of each entity, by EntityId.
+  std::vector<double> bounding_radii_;
+
+  double max_bounding_radius_ = 0.0;
+};
+
+/**
+ * @brief View of a WorldSnapshot without one entity, used by an entity to see the others.
+ * @note Copying a view only copies a pointer. The interface follows the subset of
+ * std::unordered_map<std::string, CanonicalizedEntityStatus> which was used before snapshots.
+ */
+class WorldSnapshotView
+{
+public:
+  using value_type = std::pair<const std::string &, const CanonicalizedEntityStatus &>;
+
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = WorldSnapshotView::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type;
+
+    struct pointer
+    {
+      value_type value;
+      auto operator->() const noexcept -> const value_type * { return &value; }
+    };
+
+    const_iterator() = default;
+
+    /// @note position is an index into WorldSnapshot::getIds, not an EntityId.
+    explicit const_iterator(
+      const WorldSnapshot * snapshot, std::size_t position, std::optional<EntityId> excluded_id);
+
+    auto operator*() const -> reference;
+
+    auto operator->() const -> pointer { return pointer{**this}; }
+
+    auto operator++() -> const_iterator &;
+
+    auto operator++(int) -> const_iterator;
+
+    auto operator==(const const_iterator & other) const noexcept -> bool
+    {
+      return position_ == other.position_;
+    }
+
+    auto operator!=(const const_iterator & other) const noexcept -> bool
+    {
+      return position_ != other.position_;
+    }
+
+  private:
+    auto skipExcluded() -> void;
+
+    const WorldSnapshot * snapshot_ = nullptr;
+
+    std::size_t position_ = 0;
+
+    std::optional<EntityId> excluded_id_;
+  };
+
+  using iterator = const_iterator;
+
+  WorldSnapshotView() = default;
+
+  explicit WorldSnapshotView(
+    const std::shared_ptr<const WorldSnapshot> & snapshot, const std::string & excluded_name);
+
+  auto begin() const -> const_iterator;
+
+  auto end() const -> const_iterator;
+
+  auto find(const std::string & name) const -> const_iterator;
+
+  auto at(const std::string & name) const -> const CanonicalizedEntityStatus &;
+
+  auto count(const std::string & name) const -> std::size_t { return find(name) != end(); }
+
+  auto size() const noexcept -> std::size_t;
+
+  auto empty() const noexcept -> bool { return size() == 0; }
+
+  auto getName(EntityId id) const -> const std::string &;
+
+  auto getStatus(EntityId id) const -> const CanonicalizedEntityStatus &;
+
+  /// @note Same as WorldSnapshot::getIdsOnLanelet, except that the excluded entity is not returned.
+  auto getIdsOnLanelet(std::int64_t lanelet_id) const -> std::vector<EntityId>;
+
+  /// @note Same as WorldSnapshot::getIdsWithin, except that the excluded entity is not returned.
+  auto getIdsWithin(const geometry_msgs::msg::Point & point, double distance) const
+    -> std::vector<EntityId>;
+
+  auto getSnapshot() const noexcept -> const std::shared_ptr<const WorldSnapshot> &
+  {
+    return snapshot_;
+  }
+
+private:
+  std::shared_ptr<const WorldSnapshot> snapshot_;
+
+  std::optional<EntityId> excluded_id_;
+};
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__DATA_TYPE__WORLD_SNAPSHOT_HPP_
@@ -34,6 +34,7 @@
 #include <stdexcept>
 #include <string>
 #include <traffic_simulator/api/configuration.hpp>
+#include <traffic_simulator/data_type/entity_id.hpp>
 #include <traffic_simulator/data_type/lane_change.hpp>
 #include <traffic_simulator/data_type/speed_change.hpp>
 #include <traffic_simulator/entity/ego_entity.hpp>
@@ -42,6 +43,7 @@
 #include <traffic_simulator/entity/pedestrian_entity.hpp>
 #include <traffic_simulator/entity/vehicle_entity.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <traffic_simulator/helper/thread_pool.hpp>
 #include <traffic_simulator/traffic/traffic_sink.hpp>
 #include <traffic_simulator/traffic_lights/traffic_light_marker_publisher.hpp>
 #include <traffic_simulator/traffic_lights/v2i_traffic_light_publisher.hpp>
@@ -94,7 +96,13 @@ class EntityManager
 
   const rclcpp::Clock::SharedPtr clock_ptr_;
 
-  std::unordered_map<std::string, std::unique_ptr<traffic_simulator::entity::EntityBase>> entities_;
+  /// @note Indexed by EntityId. The slot of a despawned entity is nullptr until it is reused.
+  std::vector<std::unique_ptr<traffic_simulator::entity::EntityBase>> entities_;
+
+  std::unordered_map<std::string, EntityId> entity_ids_;
+
+  /// @note Ids of the nullptr slots of entities_, reused by spawnEntity before entities_ grows.
+  std::vector<EntityId> free_entity_ids_;
 
   double step_time_;
 
@@ -102,6 +110,12 @@ class EntityManager
 
   bool npc_logic_started_;
 
+  /**
+   * @brief Pairs of colliding entities, names in each pair are sorted and so are the pairs.
+   *        Computed on demand and discarded whenever any entity status changes.
+   */
+  std::optional<std::vector<std::pair<std::string, std::string>>> colliding_pairs_;
+
   using EntityStatusWithTrajectoryArray =
     traffic_simulator_msgs::msg::EntityStatusWithTrajectoryArray;
   const rclcpp::Publisher<EntityStatusWithTrajectoryArray>::SharedPtr entity_status_array_pub_ptr_;
@@ -123,6 +137,9 @@ class EntityManager
     V2ITrafficLightPublisher<autoware_auto_perception_msgs::msg::TrafficSignalArray>>
     v2i_traffic_light_publisher_ptr_;
 
+  /// @note nullptr unless Configuration::npc_logic_thread_count is greater than 1.
+  const std::unique_ptr<helper::ThreadPool> npc_logic_thread_pool_;
+
 public:
   template <typename Node>
   auto getOrigin(Node & node) const
@@ -197,7 +214,11 @@ public:
     v2i_traffic_light_publisher_ptr_(
       std::make_shared<
         V2ITrafficLightPublisher<autoware_auto_perception_msgs::msg::TrafficSignalArray>>(
-        v2i_traffic_light_manager_ptr_, "/v2x/traffic_signals", node))
+        v2i_traffic_light_manager_ptr_, "/v2x/traffic_signals", node)),
+    npc_logic_thread_pool_(
+      configuration.npc_logic_thread_count > 1
+        ? std::make_unique<helper::ThreadPool>(configuration.npc_logic_thread_count - 1)
+        : nullptr)
   {
     updateHdmapMarker();
   }
@@ -252,7 +273,7 @@ public:
   template <typename... Ts>                                                    \
   decltype(auto) IDENTIFIER(const std::string & name, Ts &&... xs) __VA_ARGS__ \
   try {                                                                        \
-    return entities_.at(name)->IDENTIFIER(std::forward<decltype(xs)>(xs)...);  \
+    return getEntity(name).IDENTIFIER(std::forward<decltype(xs)>(xs)...);      \
   } catch (const std::out_of_range &) {                                        \
     THROW_SEMANTIC_ERROR("entity : ", name, "does not exist");                 \
   }                                                                            \
@@ -274,7 +295,7 @@ public:
   FORWARD_TO_ENTITY(getDistanceToRightLaneBound, const);
   FORWARD_TO_ENTITY(getEntityStatusBeforeUpdate, const);
   FORWARD_TO_ENTITY(getEntityType, const);
-  FORWARD_TO_ENTITY(fillLaneletPose, const);
+  FORWARD_TO_ENTITY(fillLaneletPose, );
   FORWARD_TO_ENTITY(getLaneletPose, const);
   FORWARD_TO_ENTITY(getLinearJerk, const);
   FORWARD_TO_ENTITY(getMapPose, const);
@@ -319,10 +340,15 @@ public:
     const bool continuous);
 
   auto updateNpcLogic(
-    const std::string & name,
+    EntityId id,
     const std::unordered_map<std::string, traffic_simulator_msgs::msg::EntityType> & type_list)
     -> const CanonicalizedEntityStatus &;
 
+  /// @note One snapshot per call is shared by all entities, instead of each entity copying it.
+  auto makeWorldSnapshot() const -> std::shared_ptr<const WorldSnapshot>;
+
+  auto setWorldSnapshot(const std::shared_ptr<const WorldSnapshot> &) -> void;
+
   void broadcastEntityTransform();
 
   void broadcastTransform(
@@ -330,6 +356,10 @@ public:
 
   bool checkCollision(const std::string & name0, const std::string & name1);
 
+  auto getCollidingPairs() -> const std::vector<std::pair<std::string, std::string>> &;
+
+  bool isColliding(const std::string & name);
+
   bool despawnEntity(const std::string & name);
 
   bool entityExists(const std::string & name);
@@ -347,6 +377,14 @@ public:
 
   auto getEntityNames() const -> const std::vector<std::string>;
 
+  /**
+   * @brief Resolve the name of a spawned entity to its handle.
+   * @throw common::SemanticError if no entity has the name.
+   */
+  auto getEntityId(const std::string & name) const -> EntityId;
+
+  auto getEntityName(EntityId id) const -> const std::string &;
+
   auto getEntityStatus(const std::string & name) const -> CanonicalizedEntityStatus;
 
   auto getEntityTypeList() const
@@ -397,7 +435,7 @@ public:
       if (not npc_logic_started_) {
         return {};
       } else {
-        return entities_.at(name)->getGoalPoses();
+        return getEntity(name).getGoalPoses();
       }
     } else {
       if (not npc_logic_started_) {
@@ -449,10 +487,7 @@ public:
       EntityStatus entity_status;
 
       if constexpr (std::is_same_v<std::decay_t<Entity>, EgoEntity>) {
-        if (auto iter = std::find_if(
-              std::begin(entities_), std::end(entities_),
-              [this](auto && each) { return isEgo(each.first); });
-            iter != std::end(entities_)) {
+        if (isEgoSpawned()) {
           THROW_SEMANTIC_ERROR("multi ego simulation does not support yet");
         } else {
           entity_status.type.type = traffic_simulator_msgs::msg::EntityType::EGO;
@@ -495,19 +530,27 @@ public:
       return CanonicalizedEntityStatus(entity_status, hdmap_utils_ptr_);
     };
 
-    if (const auto [iter, success] = entities_.emplace(
-          name, std::make_unique<Entity>(
-                  name, makeEntityStatus(), hdmap_utils_ptr_, parameters,
-                  std::forward<decltype(xs)>(xs)...));
-        success) {
+    if (auto status = makeEntityStatus(); entity_ids_.find(name) != entity_ids_.end()) {
+      THROW_SEMANTIC_ERROR("Entity ", std::quoted(name), " is already exists.");
+    } else {
+      auto new_entity = std::make_unique<Entity>(
+        name, status, hdmap_utils_ptr_, parameters, std::forward<decltype(xs)>(xs)...);
+      const auto id = free_entity_ids_.empty() ? entities_.size() : free_entity_ids_.back();
+      if (id == entities_.size()) {
+        entities_.push_back(std::move(new_entity));
+      } else {
+        free_entity_ids_.pop_back();
+        entities_[id] = std::move(new_entity);
+      }
+      const auto & entity = entities_[id];
+      entity_ids_.emplace(name, id);
+      colliding_pairs_.reset();
       // FIXME: this ignores V2I traffic lights
-      iter->second->setTrafficLightManager(conventional_traffic_light_manager_ptr_);
+      entity->setTrafficLightManager(conventional_traffic_light_manager_ptr_);
       if (npc_logic_started_ && not isEgo(name)) {
-        iter->second->startNpcLogic();
+        entity->startNpcLogic();
       }
-      return success;
-    } else {
-      THROW_SEMANTIC_ERROR("Entity ", std::quoted(name), " is already exists.");
+      return true;
     }
   }
 
@@ -533,6 +576,18 @@ public:
   void startNpcLogic();
 
   auto isNpcLogicStarted() const { return npc_logic_started_; }
+
+private:
+  /// @throw common::SemanticError if no entity has the name.
+  auto getEntity(const std::string & name) const -> const EntityBase &
+  {
+    return *entities_[getEntityId(name)];
+  }
+
+  /// @throw common::SemanticError if no entity has the name.
+  auto getEntity(const std::string & name) -> EntityBase & { return *entities_[getEntityId(name)]; }
+
+  static auto isEgo(const EntityBase & entity) -> bool;
 };
 }  // namespace entity
 }  // namespace traffic_simulator
@@ -45,6 +45,7 @@
 #include <lanelet2_extension/utility/utilities.hpp>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <rclcpp/rclcpp.hpp>
 #include <string>
@@ -217,6 +218,11 @@ public:
     const traffic_simulator_msgs::msg::LaneletPose & from_pose, double along) const;
   std::vector<geometry_msgs::msg::Point> getLeftBound(std::int64_t lanelet_id) const;
   std::vector<geometry_msgs::msg::Point> getRightBound(std::int64_t lanelet_id) const;
+  /**
+   * @brief Points of all line strings whose type attribute is type, such as "curbstone" or "wall".
+   */
+  auto getLineStrings(const std::string & type) const
+    -> std::vector<std::vector<geometry_msgs::msg::Point>>;
   auto getLeftLaneletIds(
     std::int64_t lanelet_id, traffic_simulator_msgs::msg::EntityType type,
     bool include_opposite_direction = true) const -> std::vector<std::int64_t>;
@@ -237,12 +243,18 @@ private:
     const traffic_simulator::lane_change::TrajectoryShape trajectory_shape,
     double tangent_vector_size = 100) const;
   /** @defgroup cache
-   *  Declared mutable for caching
+   *  Declared mutable for caching, each cache locks its own mutex so that const member functions
+   *  can be called concurrently (e.g. by NPCs updated in parallel by EntityManager::update).
+   *  center_points_mutex_ additionally serializes the miss path of getCenterPoints, so that
+   *  the spline of a lanelet is built once and every caller shares the same instance.
+   *  The lanelet map itself is only read after construction; the centerlines that lanelet2 would
+   *  otherwise compute lazily are all set in the constructor by overwriteLaneletsCenterline.
    */
   // @{
   mutable RouteCache route_cache_;
   mutable CenterPointsCache center_points_cache_;
   mutable LaneletLengthCache lanelet_length_cache_;
+  mutable std::mutex center_points_mutex_;
   // @}
 
   template <typename Lanelet>
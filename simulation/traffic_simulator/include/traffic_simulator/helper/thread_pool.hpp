@@ -0,0 +1,92 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HELPER__THREAD_POOL_HPP_
+#define TRAFFIC_SIMULATOR__HELPER__THREAD_POOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace traffic_simulator
+{
+namespace helper
+{
+/**
+ * @brief Persistent pool of worker threads running parallel loops.
+ * @note The threads are created once and sleep between loops, so a loop costs no thread creation.
+ * Indices are handed out one by one from a shared counter, so idle threads take over the remaining
+ * work of busy ones.
+ */
+class ThreadPool
+{
+public:
+  /**
+   * @param thread_count number of worker threads; the thread calling parallelFor works as well.
+   */
+  explicit ThreadPool(std::size_t thread_count);
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+
+  ThreadPool & operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief Call function(i) for every i in [0, size) and wait until all calls are finished.
+   * @note If calls throw, the exception thrown by the call with the smallest index is rethrown after
+   * all calls are finished, so the result does not depend on scheduling.
+   */
+  auto parallelFor(std::size_t size, const std::function<void(std::size_t)> & function) -> void;
+
+  auto getThreadCount() const noexcept -> std::size_t { return threads_.size(); }
+
+private:
+  auto work() -> void;
+
+  auto run() -> void;
+
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+
+  std::condition_variable start_condition_;
+
+  std::condition_variable finish_condition_;
+
+  const std::function<void(std::size_t)> * function_ = nullptr;
+
+  std::size_t size_ = 0;
+
+  std::atomic<std::size_t> next_index_ = 0;
+
+  std::size_t generation_ = 0;
+
+  std::size_t running_thread_count_ = 0;
+
+  bool is_stop_requested_ = false;
+
+  std::exception_ptr thrown_;
+
+  std::size_t thrown_index_ = 0;
+};
+}  // namespace helper
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__HELPER__THREAD_POOL_HPP_
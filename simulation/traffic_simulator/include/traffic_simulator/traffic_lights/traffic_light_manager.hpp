@@ -17,6 +17,7 @@
 
 #include <iomanip>
 #include <memory>
+#include <mutex>
 #include <rclcpp/rclcpp.hpp>
 #include <stdexcept>  // std::out_of_range
 #include <string>
@@ -38,6 +39,9 @@ protected:
   TrafficLightMap traffic_lights_;
   const std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_;
 
+  /// @note Guards the lazy construction in getTrafficLight, which NPCs may call concurrently.
+  std::mutex traffic_lights_mutex_;
+
 public:
   explicit TrafficLightManager(const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap);
 
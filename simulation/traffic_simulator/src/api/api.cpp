@@ -22,11 +22,41 @@
 #include <stdexcept>
 #include <string>
 #include <traffic_simulator/api/api.hpp>
+#include <utility>
+#include <vector>
 
 namespace traffic_simulator
 {
 void API::setVerbose(const bool verbose) { entity_manager_ptr_->setVerbose(verbose); }
 
+void API::closeZMQConnection()
+{
+  zeromq_client_.closeConnection();
+  /// @note Failing to write the statistics must not keep the simulation from shutting down.
+  if (configuration.record_rpc_statistics and not configuration.rpc_statistics_file.empty()) {
+    try {
+      simulation_interface::writeJson(
+        configuration.rpc_statistics_file, zeromq_client_.getStatistics());
+    } catch (const common::SimulationError & error) {
+      RCLCPP_ERROR_STREAM(rclcpp::get_logger("traffic_simulator"), error.what());
+    }
+  }
+}
+
+void API::publishRpcStatistics()
+{
+  if (const auto now = std::chrono::steady_clock::now();
+      configuration.record_rpc_statistics and
+      now - rpc_statistics_published_time_ >= std::chrono::seconds(1)) {
+    diagnostic_msgs::msg::DiagnosticArray diagnostics;
+    diagnostics.header.stamp = clock_.getCurrentRosTimeAsMsg().clock;
+    diagnostics.status = simulation_interface::toDiagnosticStatuses(
+      "traffic_simulator", zeromq_client_.getStatistics());
+    diagnostics_pub_->publish(diagnostics);
+    rpc_statistics_published_time_ = now;
+  }
+}
+
 bool API::despawn(const std::string & name)
 {
   const auto result = entity_manager_ptr_->despawnEntity(name);
@@ -218,17 +248,23 @@ bool API::attachLidarSensor(
     lidar_sensor_delay));
 }
 
-bool API::updateTrafficLightsInSim()
+auto API::makeUpdateTrafficLightsRequest() const
+  -> simulation_api_schema::UpdateTrafficLightsRequest
 {
   simulation_api_schema::UpdateTrafficLightsRequest req;
+  for (const auto & [id, traffic_light] : entity_manager_ptr_->getConventionalTrafficLights()) {
+    simulation_api_schema::TrafficSignal state;
+    simulation_interface::toProto(
+      static_cast<autoware_auto_perception_msgs::msg::TrafficSignal>(traffic_light), state);
+    *req.add_states() = state;
+  }
+  return req;
+}
+
+bool API::updateTrafficLightsInSim()
+{
   if (entity_manager_ptr_->trafficLightsChanged()) {
-    for (const auto & [id, traffic_light] : entity_manager_ptr_->getConventionalTrafficLights()) {
-      simulation_api_schema::TrafficSignal state;
-      simulation_interface::toProto(
-        static_cast<autoware_auto_perception_msgs::msg::TrafficSignal>(traffic_light), state);
-      *req.add_states() = state;
-    }
-    return zeromq_client_.call(req).result().success();
+    return zeromq_client_.call(makeUpdateTrafficLightsRequest()).result().success();
   }
   // TODO handle response
   return simulation_api_schema::UpdateTrafficLightsResponse().result().success();
@@ -244,73 +280,199 @@ std::optional<CanonicalizedEntityStatus> API::updateEntityStatusInSim(
   simulation_interface::toProto(status_non_canonicalized, *req.mutable_status());
   req.set_npc_logic_started(entity_manager_ptr_->isNpcLogicStarted());
   if (auto res = zeromq_client_.call(req); res.result().success()) {
-    simulation_interface::toMsg(res.status().pose(), status_non_canonicalized.pose);
-    simulation_interface::toMsg(
-      res.status().action_status(), status_non_canonicalized.action_status);
-    // Temporarily deinitialize lanelet pose as it should be correctly filled from here
-    status_non_canonicalized.lanelet_pose_valid = false;
-    status_non_canonicalized.lanelet_pose = traffic_simulator_msgs::msg::LaneletPose();
-    return std::make_optional(canonicalize(status_non_canonicalized));
+    return applyUpdatedEntityStatus(entity_name, status, res.status());
   }
   return std::nullopt;
 }
 
-bool API::updateEntityStatusInSim()
+auto API::applyUpdatedEntityStatus(
+  const std::string & entity_name, const CanonicalizedEntityStatus & status,
+  const simulation_api_schema::UpdatedEntityStatus & updated_status) const
+  -> CanonicalizedEntityStatus
 {
-  bool success = true;
+  auto status_non_canonicalized = static_cast<EntityStatus>(status);
+  status_non_canonicalized.name = entity_name;
+  simulation_interface::toMsg(updated_status.pose(), status_non_canonicalized.pose);
+  simulation_interface::toMsg(
+    updated_status.action_status(), status_non_canonicalized.action_status);
+  // Temporarily deinitialize lanelet pose as it should be correctly filled from here
+  status_non_canonicalized.lanelet_pose_valid = false;
+  status_non_canonicalized.lanelet_pose = traffic_simulator_msgs::msg::LaneletPose();
+  return canonicalize(status_non_canonicalized);
+}
+
+auto API::makeUpdateEntityStatusBatchRequest()
+  -> simulation_api_schema::UpdateEntityStatusBatchRequest
+{
+  simulation_api_schema::UpdateEntityStatusBatchRequest req;
+  std::vector<simulation_api_schema::EntityStatus> statuses;
   for (const auto & name : entity_manager_ptr_->getEntityNames()) {
     if (!entity_manager_ptr_->isEgo(name)) {
-      success &= static_cast<bool>(
-        updateEntityStatusInSim(name, entity_manager_ptr_->getEntityStatus(name)));
+      auto status = static_cast<EntityStatus>(entity_manager_ptr_->getEntityStatus(name));
+      status.name = name;
+      simulation_interface::toProto(status, statuses.emplace_back());
     }
   }
-  return success;
+  if (configuration.delta_encode_entity_status) {
+    *req.mutable_delta() =
+      entity_status_encoder_.encode(statuses, clock_.getCurrentSimulationTime());
+  } else {
+    for (auto && status : statuses) {
+      *req.add_status() = std::move(status);
+    }
+  }
+  req.set_npc_logic_started(entity_manager_ptr_->isNpcLogicStarted());
+  /// @note The statuses of NPCs updated by the simulator are not used.
+  req.set_omit_updated_status(true);
+  return req;
 }
 
-bool API::updateFrame()
+auto API::makeUpdateFrameRequest() const -> simulation_api_schema::UpdateFrameRequest
 {
-  if (entity_manager_ptr_->isEgoSpawned()) {
-    if (configuration.standalone_mode) {
-      THROW_SEMANTIC_ERROR("Ego simulation is no longer supported in standalone mode");
-    }
-    if (not entity_manager_ptr_->isEgoSpawned()) {
-      THROW_SIMULATION_ERROR(
-        "This exception is basically not supposed to be sent. Contact the developer as there is "
-        "some kind of bug.");
+  simulation_api_schema::UpdateFrameRequest req;
+  req.set_current_time(clock_.getCurrentSimulationTime());
+  simulation_interface::toProto(
+    clock_.getCurrentRosTimeAsMsg().clock, *req.mutable_current_ros_time());
+  return req;
+}
+
+auto API::makeStepRequest() -> simulation_api_schema::StepRequest
+{
+  simulation_api_schema::StepRequest req;
+  *req.mutable_entity_status() = makeUpdateEntityStatusBatchRequest();
+  if (entity_manager_ptr_->trafficLightsChanged()) {
+    *req.mutable_traffic_lights() = makeUpdateTrafficLightsRequest();
+  }
+  *req.mutable_frame() = makeUpdateFrameRequest();
+  return req;
+}
+
+bool API::applyStepResponse(const simulation_api_schema::StepResponse & res, bool npc_logic_started)
+{
+  if (res.result().success()) {
+    if (res.has_ego_status()) {
+      next_ego_status_ = res.ego_status();
+      next_ego_status_npc_logic_started_ = npc_logic_started;
     }
+    return true;
+  } else {
+    return false;
+  }
+}
 
-    auto ego_name = entity_manager_ptr_->getEgoName();
-    auto ego_status = entity_manager_ptr_->getEntityStatus(ego_name);
-    auto ego_status_opt = updateEntityStatusInSim(entity_manager_ptr_->getEgoName(), ego_status);
-    if (ego_status_opt) {
-      ego_status = *ego_status_opt;
+bool API::stepInSim()
+{
+  auto req = makeStepRequest();
+  const auto npc_logic_started = req.entity_status().npc_logic_started();
+  if (configuration.overlap_step_in_sim) {
+    pending_step_ = zeromq_client_.callAsync(std::move(req));
+    pending_step_npc_logic_started_ = npc_logic_started;
+    return true;
+  } else {
+    return applyStepResponse(zeromq_client_.call(std::move(req)), npc_logic_started);
+  }
+}
+
+bool API::waitForStepInSim()
+{
+  if (pending_step_.valid()) {
+    return applyStepResponse(pending_step_.get(), pending_step_npc_logic_started_);
+  } else {
+    return true;
+  }
+}
+
+bool API::updateEntityStatusInSim()
+{
+  if (configuration.update_entity_status_in_batch) {
+    return zeromq_client_.call(makeUpdateEntityStatusBatchRequest()).result().success();
+  } else {
+    bool success = true;
+    for (const auto & name : entity_manager_ptr_->getEntityNames()) {
+      if (!entity_manager_ptr_->isEgo(name)) {
+        success &= static_cast<bool>(
+          updateEntityStatusInSim(name, entity_manager_ptr_->getEntityStatus(name)));
+      }
     }
-    /// @note apply additional status data (from ll2) to ego_entity_simulation_ for this update
-    entity_manager_ptr_->fillLaneletPose(ego_name, ego_status);
-    entity_manager_ptr_->setEntityStatusExternally(ego_name, ego_status);
+    return success;
+  }
+}
+
+void API::updateEgoEntityStatusInSim()
+{
+  if (configuration.standalone_mode) {
+    THROW_SEMANTIC_ERROR("Ego simulation is no longer supported in standalone mode");
+  }
+  if (not entity_manager_ptr_->isEgoSpawned()) {
+    THROW_SIMULATION_ERROR(
+      "This exception is basically not supposed to be sent. Contact the developer as there is "
+      "some kind of bug.");
+  }
+
+  auto ego_name = entity_manager_ptr_->getEgoName();
+  auto ego_status = entity_manager_ptr_->getEntityStatus(ego_name);
+  /**
+   * @note The last StepRequest has already updated the ego entity for this frame, but with the
+   * npc_logic_started flag it was built with, so the ego entity is updated again if it changed.
+   */
+  if (
+    next_ego_status_ and next_ego_status_->name() == ego_name and
+    next_ego_status_npc_logic_started_ == entity_manager_ptr_->isNpcLogicStarted()) {
+    ego_status = applyUpdatedEntityStatus(ego_name, ego_status, next_ego_status_.value());
+  } else if (auto ego_status_opt = updateEntityStatusInSim(ego_name, ego_status); ego_status_opt) {
+    ego_status = *ego_status_opt;
+  }
+  next_ego_status_.reset();
+  /// @note apply additional status data (from ll2) to ego_entity_simulation_ for this update
+  entity_manager_ptr_->fillLaneletPose(ego_name, ego_status);
+  entity_manager_ptr_->setEntityStatusExternally(ego_name, ego_status);
+}
+
+bool API::updateFrame()
+{
+  /// @note In overlap mode, the NPC logic of this frame runs before waiting for the previous step.
+  const auto overlap_step_in_sim = configuration.overlap_step_in_sim and
+                                   configuration.step_in_single_request and
+                                   not configuration.standalone_mode;
+
+  if (not overlap_step_in_sim and entity_manager_ptr_->isEgoSpawned()) {
+    updateEgoEntityStatusInSim();
   }
 
   entity_manager_ptr_->update(clock_.getCurrentSimulationTime(), clock_.getStepTime());
   traffic_controller_ptr_->execute();
 
   if (not configuration.standalone_mode) {
-    if (!updateEntityStatusInSim()) {
-      return false;
-    }
-    if (!updateTrafficLightsInSim()) {
-      return false;
-    }
-    simulation_api_schema::UpdateFrameRequest req;
-    req.set_current_time(clock_.getCurrentSimulationTime());
-    simulation_interface::toProto(
-      clock_.getCurrentRosTimeAsMsg().clock, *req.mutable_current_ros_time());
-    if (not zeromq_client_.call(req).result().success()) {
-      return false;
+    if (overlap_step_in_sim) {
+      if (!waitForStepInSim()) {
+        return false;
+      }
+      if (entity_manager_ptr_->isEgoSpawned()) {
+        updateEgoEntityStatusInSim();
+      }
+      if (!stepInSim()) {
+        return false;
+      }
+    } else if (configuration.step_in_single_request) {
+      if (!stepInSim()) {
+        return false;
+      }
+    } else {
+      if (!updateEntityStatusInSim()) {
+        return false;
+      }
+      if (!updateTrafficLightsInSim()) {
+        return false;
+      }
+      if (not zeromq_client_.call(makeUpdateFrameRequest()).result().success()) {
+        return false;
+      }
     }
     entity_manager_ptr_->broadcastEntityTransform();
     clock_.update();
     clock_pub_->publish(clock_.getCurrentRosTimeAsMsg());
     debug_marker_pub_->publish(entity_manager_ptr_->makeDebugMarker());
+    publishRpcStatistics();
     return true;
   } else {
     entity_manager_ptr_->broadcastEntityTransform();
@@ -0,0 +1,38 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <traffic_simulator/behavior/behavior_plugin_loader.hpp>
+
+namespace entity_behavior
+{
+BehaviorPluginLoader::BehaviorPluginLoader()
+: loader_("traffic_simulator", "entity_behavior::BehaviorPluginBase")
+{
+}
+
+auto BehaviorPluginLoader::get() -> std::shared_ptr<BehaviorPluginLoader>
+{
+  static const std::shared_ptr<BehaviorPluginLoader> loader(new BehaviorPluginLoader());
+  return loader;
+}
+
+auto BehaviorPluginLoader::createSharedInstance(const std::string & plugin_name)
+  -> std::shared_ptr<BehaviorPluginBase>
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return loader_.createSharedInstance(plugin_name);
+}
+}  // namespace entity_behavior
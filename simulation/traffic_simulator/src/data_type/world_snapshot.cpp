@@ -0,0 +1,257 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <scenario_simulator_exception/exception.hpp>
+#include <traffic_simulator/data_type/world_snapshot.hpp>
+
+namespace traffic_simulator
+{
+auto WorldSnapshot::emplace(
+  EntityId id, const std::string & name, const CanonicalizedEntityStatus & status) -> void
+{
+  if (ids_by_name_.find(name) != ids_by_name_.end()) {
+    THROW_SIMULATION_ERROR("Entity ", std::quoted(name), " is already in the world snapshot.");
+  } else if (contains(id)) {
+    THROW_SIMULATION_ERROR("Entity id ", id, " is already in the world snapshot.");
+  }
+  if (statuses_.size() <= id) {
+    names_.resize(id + 1);
+    statuses_.resize(id + 1);
+    bounding_radii_.resize(id + 1, 0.0);
+  }
+  names_[id] = name;
+  statuses_[id].emplace(status);
+  ids_.insert(std::upper_bound(ids_.begin(), ids_.end(), id), id);
+  ids_by_name_.emplace(name, id);
+  if (status.laneMatchingSucceed()) {
+    auto & bucket = lanelet_buckets_[status.getLaneletPose().lanelet_id];
+    bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), id), id);
+  }
+  const auto position = status.getMapPose().position;
+  grid_cells_[getCellKey(getCellIndex(position.x), getCellIndex(position.y))].push_back(id);
+  const auto bounding_box = status.getBoundingBox();
+  bounding_radii_[id] = std::hypot(
+    std::fabs(bounding_box.center.x) + bounding_box.dimensions.x * 0.5,
+    std::fabs(bounding_box.center.y) + bounding_box.dimensions.y * 0.5);
+  max_bounding_radius_ = std::max(max_bounding_radius_, bounding_radii_[id]);
+}
+
+auto WorldSnapshot::getName(EntityId id) const -> const std::string &
+{
+  if (not contains(id)) {
+    THROW_SIMULATION_ERROR("Entity id ", id, " is not in the world snapshot.");
+  }
+  return names_[id];
+}
+
+auto WorldSnapshot::getStatus(EntityId id) const -> const CanonicalizedEntityStatus &
+{
+  if (not contains(id)) {
+    THROW_SIMULATION_ERROR("Entity id ", id, " is not in the world snapshot.");
+  }
+  return statuses_[id].value();
+}
+
+auto WorldSnapshot::findId(const std::string & name) const -> std::optional<EntityId>
+{
+  if (const auto iter = ids_by_name_.find(name); iter != ids_by_name_.end()) {
+    return iter->second;
+  } else {
+    return std::nullopt;
+  }
+}
+
+auto WorldSnapshot::getIdsOnLanelet(std::int64_t lanelet_id) const
+  -> const std::vector<EntityId> &
+{
+  static const std::vector<EntityId> empty;
+  if (const auto iter = lanelet_buckets_.find(lanelet_id); iter != lanelet_buckets_.end()) {
+    return iter->second;
+  } else {
+    return empty;
+  }
+}
+
+auto WorldSnapshot::getIdsWithin(const geometry_msgs::msg::Point & point, double distance) const
+  -> std::vector<EntityId>
+{
+  const auto is_within = [&](EntityId id) {
+    const auto position = statuses_[id]->getMapPose().position;
+    return std::hypot(position.x - point.x, position.y - point.y) <= distance + bounding_radii_[id];
+  };
+  std::vector<EntityId> ids;
+  const auto search_distance = distance + max_bounding_radius_;
+  const auto min_x = getCellIndex(point.x - search_distance);
+  const auto max_x = getCellIndex(point.x + search_distance);
+  const auto min_y = getCellIndex(point.y - search_distance);
+  const auto max_y = getCellIndex(point.y + search_distance);
+  /// @note If the search area covers more cells than entities, checking all entities is cheaper.
+  if (
+    not std::isfinite(search_distance) or
+    static_cast<double>(max_x - min_x + 1) * static_cast<double>(max_y - min_y + 1) >
+      static_cast<double>(size())) {
+    std::copy_if(ids_.begin(), ids_.end(), std::back_inserter(ids), is_within);
+    return ids;
+  }
+  for (auto x = min_x; x <= max_x; ++x) {
+    for (auto y = min_y; y <= max_y; ++y) {
+      if (const auto iter = grid_cells_.find(getCellKey(x, y)); iter != grid_cells_.end()) {
+        std::copy_if(
+          iter->second.begin(), iter->second.end(), std::back_inserter(ids), is_within);
+      }
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+auto WorldSnapshot::getCellIndex(double coordinate) -> std::int64_t
+{
+  return static_cast<std::int64_t>(std::floor(coordinate / grid_cell_size));
+}
+
+auto WorldSnapshot::getCellKey(std::int64_t x_index, std::int64_t y_index) -> std::uint64_t
+{
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x_index)) << 32) |
+         static_cast<std::uint32_t>(y_index);
+}
+
+WorldSnapshotView::const_iterator::const_iterator(
+  const WorldSnapshot * snapshot, std::size_t position, std::optional<EntityId> excluded_id)
+: snapshot_(snapshot), position_(position), excluded_id_(excluded_id)
+{
+  skipExcluded();
+}
+
+auto WorldSnapshotView::const_iterator::operator*() const -> reference
+{
+  const auto id = snapshot_->getIds()[position_];
+  return reference(snapshot_->getName(id), snapshot_->getStatus(id));
+}
+
+auto WorldSnapshotView::const_iterator::operator++() -> const_iterator &
+{
+  ++position_;
+  skipExcluded();
+  return *this;
+}
+
+auto WorldSnapshotView::const_iterator::operator++(int) -> const_iterator
+{
+  auto copy = *this;
+  ++*this;
+  return copy;
+}
+
+auto WorldSnapshotView::const_iterator::skipExcluded() -> void
+{
+  if (
+    excluded_id_ and position_ < snapshot_->size() and
+    snapshot_->getIds()[position_] == excluded_id_.value()) {
+    ++position_;
+  }
+}
+
+WorldSnapshotView::WorldSnapshotView(
+  const std::shared_ptr<const WorldSnapshot> & snapshot, const std::string & excluded_name)
+: snapshot_(snapshot), excluded_id_(snapshot ? snapshot->findId(excluded_name) : std::nullopt)
+{
+}
+
+auto WorldSnapshotView::begin() const -> const_iterator
+{
+  return const_iterator(snapshot_.get(), 0, excluded_id_);
+}
+
+auto WorldSnapshotView::end() const -> const_iterator
+{
+  return const_iterator(snapshot_.get(), snapshot_ ? snapshot_->size() : 0, excluded_id_);
+}
+
+auto WorldSnapshotView::find(const std::string & name) const -> const_iterator
+{
+  if (snapshot_) {
+    if (const auto id = snapshot_->findId(name); id and id != excluded_id_) {
+      const auto & ids = snapshot_->getIds();
+      const auto position = std::lower_bound(ids.begin(), ids.end(), id.value()) - ids.begin();
+      return const_iterator(snapshot_.get(), static_cast<std::size_t>(position), excluded_id_);
+    }
+  }
+  return end();
+}
+
+auto WorldSnapshotView::at(const std::string & name) const -> const CanonicalizedEntityStatus &
+{
+  if (const auto iter = find(name); iter != end()) {
+    return iter->second;
+  } else {
+    THROW_SIMULATION_ERROR("Entity ", std::quoted(name), " is not in the world snapshot.");
+  }
+}
+
+auto WorldSnapshotView::getName(EntityId id) const -> const std::string &
+{
+  if (not snapshot_) {
+    THROW_SIMULATION_ERROR("World snapshot is not set.");
+  }
+  return snapshot_->getName(id);
+}
+
+auto WorldSnapshotView::getStatus(EntityId id) const -> const CanonicalizedEntityStatus &
+{
+  if (not snapshot_) {
+    THROW_SIMULATION_ERROR("World snapshot is not set.");
+  }
+  return snapshot_->getStatus(id);
+}
+
+auto WorldSnapshotView::getIdsOnLanelet(std::int64_t lanelet_id) const
+  -> std::vector<EntityId>
+{
+  std::vector<EntityId> ids;
+  if (snapshot_) {
+    for (const auto id : snapshot_->getIdsOnLanelet(lanelet_id)) {
+      if (id != excluded_id_) {
+        ids.push_back(id);
+      }
+    }
+  }
+  return ids;
+}
+
+auto WorldSnapshotView::getIdsWithin(const geometry_msgs::msg::Point & point, double distance) const
+  -> std::vector<EntityId>
+{
+  if (not snapshot_) {
+    return {};
+  }
+  auto ids = snapshot_->getIdsWithin(point, distance);
+  if (excluded_id_) {
+    ids.erase(std::remove(ids.begin(), ids.end(), excluded_id_.value()), ids.end());
+  }
+  return ids;
+}
+
+auto WorldSnapshotView::size() const noexcept -> std::size_t
+{
+  if (not snapshot_) {
+    return 0;
+  } else {
+    return snapshot_->size() - (excluded_id_ ? 1 : 0);
+  }
+}
+}  // namespace traffic_simulator
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cstdint>
 #include <geometry/bounding_box.hpp>
 #include <geometry/distance.hpp>
@@ -70,28 +71,69 @@ void EntityManager::broadcastTransform(
 
 bool EntityManager::checkCollision(const std::string & name0, const std::string & name1)
 {
-  return name0 != name1 and
-         math::geometry::checkCollision2D(
-           getMapPose(name0), getBoundingBox(name0), getMapPose(name1), getBoundingBox(name1));
+  if (not entityExists(name0)) {
+    THROW_SEMANTIC_ERROR("entity ", std::quoted(name0), " does not exist.");
+  } else if (not entityExists(name1)) {
+    THROW_SEMANTIC_ERROR("entity ", std::quoted(name1), " does not exist.");
+  } else {
+    const auto & pairs = getCollidingPairs();
+    return name0 != name1 and
+           std::binary_search(
+             pairs.begin(), pairs.end(),
+             std::pair<std::string, std::string>(std::minmax(name0, name1)));
+  }
+}
+
+auto EntityManager::getCollidingPairs() -> const std::vector<std::pair<std::string, std::string>> &
+{
+  if (not colliding_pairs_) {
+    std::vector<std::string> names;
+    std::vector<geometry_msgs::msg::Pose> poses;
+    std::vector<traffic_simulator_msgs::msg::BoundingBox> bounding_boxes;
+    for (const auto & entity : entities_) {
+      if (entity) {
+        names.push_back(entity->name);
+        poses.push_back(entity->getMapPose());
+        bounding_boxes.push_back(entity->getBoundingBox());
+      }
+    }
+    std::vector<std::pair<std::string, std::string>> pairs;
+    for (const auto & [i, j] : math::geometry::getCollidingPairs2D(poses, bounding_boxes)) {
+      pairs.push_back(std::minmax(names[i], names[j]));
+    }
+    std::sort(pairs.begin(), pairs.end());
+    colliding_pairs_ = std::move(pairs);
+  }
+  return colliding_pairs_.value();
 }
 
 visualization_msgs::msg::MarkerArray EntityManager::makeDebugMarker() const
 {
   visualization_msgs::msg::MarkerArray marker;
   for (const auto & entity : entities_) {
-    entity.second->appendDebugMarker(marker);
+    if (entity) {
+      entity->appendDebugMarker(marker);
+    }
   }
   return marker;
 }
 
 bool EntityManager::despawnEntity(const std::string & name)
 {
-  return entityExists(name) && entities_.erase(name);
+  colliding_pairs_.reset();
+  if (const auto iter = entity_ids_.find(name); iter != entity_ids_.end()) {
+    entities_[iter->second].reset();
+    free_entity_ids_.push_back(iter->second);
+    entity_ids_.erase(iter);
+    return true;
+  } else {
+    return false;
+  }
 }
 
 bool EntityManager::entityExists(const std::string & name)
 {
-  return entities_.find(name) != std::end(entities_);
+  return entity_ids_.find(name) != entity_ids_.end();
 }
 
 auto EntityManager::getBoundingBoxDistance(const std::string & from, const std::string & to)
@@ -106,7 +148,7 @@ auto EntityManager::getCurrentTime() const noexcept -> double { return current_t
 auto EntityManager::getDistanceToCrosswalk(
   const std::string & name, const std::int64_t target_crosswalk_id) -> std::optional<double>
 {
-  if (entities_.find(name) == entities_.end()) {
+  if (not entityExists(name)) {
     return std::nullopt;
   }
   if (getWaypoints(name).waypoints.empty()) {
@@ -120,7 +162,7 @@ auto EntityManager::getDistanceToCrosswalk(
 auto EntityManager::getDistanceToStopLine(
   const std::string & name, const std::int64_t target_stop_line_id) -> std::optional<double>
 {
-  if (entities_.find(name) == entities_.end()) {
+  if (not entityExists(name)) {
     return std::nullopt;
   }
   if (getWaypoints(name).waypoints.empty()) {
@@ -134,18 +176,38 @@ auto EntityManager::getDistanceToStopLine(
 auto EntityManager::getEntityNames() const -> const std::vector<std::string>
 {
   std::vector<std::string> names{};
-  for (const auto & each : entities_) {
-    names.push_back(each.first);
+  for (const auto & entity : entities_) {
+    if (entity) {
+      names.push_back(entity->name);
+    }
   }
   return names;
 }
 
+auto EntityManager::getEntityId(const std::string & name) const -> EntityId
+{
+  if (const auto iter = entity_ids_.find(name); iter == entity_ids_.end()) {
+    THROW_SEMANTIC_ERROR("entity ", std::quoted(name), " does not exist.");
+  } else {
+    return iter->second;
+  }
+}
+
+auto EntityManager::getEntityName(EntityId id) const -> const std::string &
+{
+  if (id >= entities_.size() or not entities_[id]) {
+    THROW_SEMANTIC_ERROR("entity with id ", id, " does not exist.");
+  } else {
+    return entities_[id]->name;
+  }
+}
+
 auto EntityManager::getEntityStatus(const std::string & name) const -> CanonicalizedEntityStatus
 {
-  if (const auto iter = entities_.find(name); iter == entities_.end()) {
+  if (const auto iter = entity_ids_.find(name); iter == entity_ids_.end()) {
     THROW_SEMANTIC_ERROR("entity ", std::quoted(name), " does not exist.");
   } else {
-    auto entity_status = static_cast<EntityStatus>(iter->second->getStatus());
+    auto entity_status = static_cast<EntityStatus>(entities_[iter->second]->getStatus());
     entity_status.action_status.current_action = getCurrentAction(name);
     entity_status.time = current_time_;
     return CanonicalizedEntityStatus(entity_status, hdmap_utils_ptr_);
@@ -156,8 +218,10 @@ auto EntityManager::getEntityTypeList() const
   -> const std::unordered_map<std::string, traffic_simulator_msgs::msg::EntityType>
 {
   std::unordered_map<std::string, traffic_simulator_msgs::msg::EntityType> ret;
-  for (auto && [name, entity] : entities_) {
-    ret.emplace(name, getEntityType(name));
+  for (const auto & entity : entities_) {
+    if (entity) {
+      ret.emplace(entity->name, entity->getEntityType());
+    }
   }
   return ret;
 }
@@ -362,8 +426,8 @@ auto EntityManager::getLongitudinalDistance(
 
 auto EntityManager::getNumberOfEgo() const -> std::size_t
 {
-  return std::count_if(std::begin(entities_), std::end(entities_), [this](const auto & each) {
-    return isEgo(each.first);
+  return std::count_if(std::begin(entities_), std::end(entities_), [](const auto & entity) {
+    return entity and isEgo(*entity);
   });
 }
 
@@ -386,7 +450,7 @@ auto EntityManager::getObstacle(const std::string & name)
   if (!npc_logic_started_) {
     return std::nullopt;
   }
-  return entities_.at(name)->getObstacle();
+  return getEntity(name).getObstacle();
 }
 
 auto EntityManager::getRelativePose(
@@ -448,26 +512,32 @@ auto EntityManager::getWaypoints(const std::string & name)
   if (!npc_logic_started_) {
     return traffic_simulator_msgs::msg::WaypointsArray();
   }
-  return entities_.at(name)->getWaypoints();
+  return getEntity(name).getWaypoints();
 }
 
-bool EntityManager::isEgo(const std::string & name) const
+bool EntityManager::isEgo(const std::string & name) const { return isEgo(getEntity(name)); }
+
+auto EntityManager::isEgo(const EntityBase & entity) -> bool
 {
   using traffic_simulator_msgs::msg::EntityType;
-  return getEntityType(name).type == EntityType::EGO and
-         dynamic_cast<EgoEntity const *>(entities_.at(name).get());
+  return entity.getEntityType().type == EntityType::EGO and
+         dynamic_cast<EgoEntity const *>(&entity);
 }
 
-bool EntityManager::isEgoSpawned() const
+bool EntityManager::isColliding(const std::string & name)
 {
-  for (const auto & name : getEntityNames()) {
-    if (isEgo(name)) {
-      return true;
-    }
+  if (not entityExists(name)) {
+    THROW_SEMANTIC_ERROR("entity ", std::quoted(name), " does not exist.");
+  } else {
+    const auto & pairs = getCollidingPairs();
+    return std::any_of(pairs.begin(), pairs.end(), [&](const auto & pair) {
+      return pair.first == name or pair.second == name;
+    });
   }
-  return false;
 }
 
+bool EntityManager::isEgoSpawned() const { return getNumberOfEgo() != 0; }
+
 bool EntityManager::isInLanelet(
   const std::string & name, const std::int64_t lanelet_id, const double tolerance)
 {
@@ -542,7 +612,7 @@ void EntityManager::requestSpeedChange(
   if (isEgo(name) && getCurrentTime() > 0) {
     THROW_SEMANTIC_ERROR("You cannot set target speed to the ego vehicle after starting scenario.");
   }
-  return entities_.at(name)->requestSpeedChange(target_speed, continuous);
+  return getEntity(name).requestSpeedChange(target_speed, continuous);
 }
 
 void EntityManager::requestSpeedChange(
@@ -552,7 +622,7 @@ void EntityManager::requestSpeedChange(
   if (isEgo(name) && getCurrentTime() > 0) {
     THROW_SEMANTIC_ERROR("You cannot set target speed to the ego vehicle after starting scenario.");
   }
-  return entities_.at(name)->requestSpeedChange(target_speed, transition, constraint, continuous);
+  return getEntity(name).requestSpeedChange(target_speed, transition, constraint, continuous);
 }
 
 void EntityManager::requestSpeedChange(
@@ -561,7 +631,7 @@ void EntityManager::requestSpeedChange(
   if (isEgo(name) && getCurrentTime() > 0) {
     THROW_SEMANTIC_ERROR("You cannot set target speed to the ego vehicle after starting scenario.");
   }
-  return entities_.at(name)->requestSpeedChange(target_speed, continuous);
+  return getEntity(name).requestSpeedChange(target_speed, continuous);
 }
 
 void EntityManager::requestSpeedChange(
@@ -572,7 +642,7 @@ void EntityManager::requestSpeedChange(
   if (isEgo(name) && getCurrentTime() > 0) {
     THROW_SEMANTIC_ERROR("You cannot set target speed to the ego vehicle after starting scenario.");
   }
-  return entities_.at(name)->requestSpeedChange(target_speed, transition, constraint, continuous);
+  return getEntity(name).requestSpeedChange(target_speed, transition, constraint, continuous);
 }
 
 auto EntityManager::setEntityStatus(
@@ -583,7 +653,8 @@ auto EntityManager::setEntityStatus(
       "You cannot set entity status to the ego vehicle name ", std::quoted(name),
       " after starting scenario.");
   } else {
-    entities_.at(name)->setStatus(status);
+    colliding_pairs_.reset();
+    getEntity(name).setStatus(status);
   }
 }
 
@@ -595,7 +666,8 @@ auto EntityManager::setEntityStatusExternally(
       "You cannot set entity status externally to the vehicle other than ego named ",
       std::quoted(name), ".");
   } else {
-    dynamic_cast<EgoEntity *>(entities_[name].get())->setStatusExternally(status);
+    colliding_pairs_.reset();
+    dynamic_cast<EgoEntity &>(getEntity(name)).setStatusExternally(status);
   }
 }
 
@@ -603,7 +675,9 @@ void EntityManager::setVerbose(const bool verbose)
 {
   configuration.verbose = verbose;
   for (auto & entity : entities_) {
-    entity.second->verbose = verbose;
+    if (entity) {
+      entity->verbose = verbose;
+    }
   }
 }
 
@@ -614,16 +688,37 @@ auto EntityManager::toMapPose(const CanonicalizedLaneletPose & lanelet_pose) con
 }
 
 auto EntityManager::updateNpcLogic(
-  const std::string & name,
+  EntityId id,
   const std::unordered_map<std::string, traffic_simulator_msgs::msg::EntityType> & type_list)
   -> const CanonicalizedEntityStatus &
 {
+  const auto & entity = entities_.at(id);
   if (configuration.verbose) {
-    std::cout << "update " << name << " behavior" << std::endl;
+    std::cout << "update " << entity->name << " behavior" << std::endl;
+  }
+  entity->setEntityTypeList(type_list);
+  entity->onUpdate(current_time_, step_time_);
+  return entity->getStatus();
+}
+
+auto EntityManager::makeWorldSnapshot() const -> std::shared_ptr<const WorldSnapshot>
+{
+  auto snapshot = std::make_shared<WorldSnapshot>();
+  for (EntityId id = 0; id < entities_.size(); ++id) {
+    if (const auto & entity = entities_[id]) {
+      snapshot->emplace(id, entity->name, entity->getStatus());
+    }
+  }
+  return snapshot;
+}
+
+auto EntityManager::setWorldSnapshot(const std::shared_ptr<const WorldSnapshot> & snapshot) -> void
+{
+  for (const auto & entity : entities_) {
+    if (entity) {
+      entity->setOtherStatus(snapshot);
+    }
   }
-  entities_[name]->setEntityTypeList(type_list);
-  entities_[name]->onUpdate(current_time_, step_time_);
-  return entities_[name]->getStatus();
 }
 
 void EntityManager::update(const double current_time, const double step_time)
@@ -641,22 +736,35 @@ void EntityManager::update(const double current_time, const double step_time)
       configuration.v2i_traffic_light_publish_rate);
   }
   auto type_list = getEntityTypeList();
-  std::unordered_map<std::string, CanonicalizedEntityStatus> all_status;
-  for (auto && [name, entity] : entities_) {
-    all_status.emplace(name, entity->getStatus());
-  }
-  for (auto && [name, entity] : entities_) {
-    entity->setOtherStatus(all_status);
-  }
-  all_status.clear();
-  for (auto && [name, entity] : entities_) {
-    all_status.emplace(name, updateNpcLogic(name, type_list));
-  }
-  for (auto && [name, entity] : entities_) {
-    entity->setOtherStatus(all_status);
+  setWorldSnapshot(makeWorldSnapshot());
+  if (npc_logic_thread_pool_) {
+    /// @note The ego entity communicates with Autoware, so it is always updated on this thread.
+    std::vector<EntityId> npc_ids;
+    for (EntityId id = 0; id < entities_.size(); ++id) {
+      if (not entities_[id]) {
+        continue;
+      } else if (isEgo(*entities_[id])) {
+        updateNpcLogic(id, type_list);
+      } else {
+        npc_ids.push_back(id);
+      }
+    }
+    npc_logic_thread_pool_->parallelFor(
+      npc_ids.size(), [&](std::size_t i) { updateNpcLogic(npc_ids[i], type_list); });
+  } else {
+    for (EntityId id = 0; id < entities_.size(); ++id) {
+      if (entities_[id]) {
+        updateNpcLogic(id, type_list);
+      }
+    }
   }
+  colliding_pairs_.reset();
+  const auto world_snapshot = makeWorldSnapshot();
+  setWorldSnapshot(world_snapshot);
   traffic_simulator_msgs::msg::EntityStatusWithTrajectoryArray status_array_msg;
-  for (auto && [name, status] : all_status) {
+  for (const auto id : world_snapshot->getIds()) {
+    const auto & name = world_snapshot->getName(id);
+    const auto & status = world_snapshot->getStatus(id);
     traffic_simulator_msgs::msg::EntityStatusWithTrajectory status_with_trajectory;
     status_with_trajectory.waypoint = getWaypoints(name);
     for (const auto & goal : getGoalPoses<geometry_msgs::msg::Pose>(name)) {
@@ -695,8 +803,10 @@ void EntityManager::updateHdmapMarker()
 void EntityManager::startNpcLogic()
 {
   npc_logic_started_ = true;
-  for (auto it = entities_.begin(); it != entities_.end(); it++) {
-    it->second->startNpcLogic();
+  for (const auto & entity : entities_) {
+    if (entity) {
+      entity->startNpcLogic();
+    }
   }
 }
 
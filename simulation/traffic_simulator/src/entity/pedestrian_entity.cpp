@@ -31,9 +31,8 @@ PedestrianEntity::PedestrianEntity(
   const std::string & plugin_name)
 : EntityBase(name, entity_status, hdmap_utils_ptr),
   plugin_name(plugin_name),
-  loader_(pluginlib::ClassLoader<entity_behavior::BehaviorPluginBase>(
-    "traffic_simulator", "entity_behavior::BehaviorPluginBase")),
-  behavior_plugin_ptr_(loader_.createSharedInstance(plugin_name)),
+  loader_(entity_behavior::BehaviorPluginLoader::get()),
+  behavior_plugin_ptr_(loader_->createSharedInstance(plugin_name)),
   route_planner_(hdmap_utils_ptr_)
 {
   behavior_plugin_ptr_->configure(rclcpp::get_logger(name));
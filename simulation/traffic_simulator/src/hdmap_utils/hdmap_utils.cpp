@@ -903,6 +903,11 @@ std::vector<geometry_msgs::msg::Point> HdMapUtils::getCenterPoints(std::int64_t
   if (center_points_cache_.exists(lanelet_id)) {
     return center_points_cache_.getCenterPoints(lanelet_id);
   }
+  /// @note Serialize the miss path so that NPCs updated in parallel build each entry only once.
+  std::lock_guard<std::mutex> lock(center_points_mutex_);
+  if (center_points_cache_.exists(lanelet_id)) {
+    return center_points_cache_.getCenterPoints(lanelet_id);
+  }
 
   const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
   const auto centerline = lanelet.centerline();
@@ -1162,6 +1167,20 @@ std::vector<geometry_msgs::msg::Point> HdMapUtils::getRightBound(std::int64_t la
   return toPolygon(lanelet_map_ptr_->laneletLayer.get(lanelet_id).rightBound());
 }
 
+auto HdMapUtils::getLineStrings(const std::string & type) const
+  -> std::vector<std::vector<geometry_msgs::msg::Point>>
+{
+  std::vector<std::vector<geometry_msgs::msg::Point>> line_strings;
+  for (const auto & line_string : lanelet_map_ptr_->lineStringLayer) {
+    if (
+      line_string.hasAttribute(lanelet::AttributeName::Type) and
+      line_string.attribute(lanelet::AttributeName::Type).value() == type) {
+      line_strings.push_back(toPolygon(line_string));
+    }
+  }
+  return line_strings;
+}
+
 auto HdMapUtils::getLeftLaneletIds(
   std::int64_t lanelet_id, traffic_simulator_msgs::msg::EntityType type,
   bool include_opposite_direction) const -> std::vector<std::int64_t>
@@ -0,0 +1,105 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <traffic_simulator/helper/thread_pool.hpp>
+#include <utility>
+
+namespace traffic_simulator
+{
+namespace helper
+{
+ThreadPool::ThreadPool(std::size_t thread_count)
+{
+  threads_.reserve(thread_count);
+  for (std::size_t i = 0; i < thread_count; ++i) {
+    threads_.emplace_back([this]() { work(); });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stop_requested_ = true;
+  }
+  start_condition_.notify_all();
+  for (auto && thread : threads_) {
+    thread.join();
+  }
+}
+
+auto ThreadPool::parallelFor(std::size_t size, const std::function<void(std::size_t)> & function)
+  -> void
+{
+  if (size == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    function_ = &function;
+    size_ = size;
+    next_index_ = 0;
+    thrown_ = nullptr;
+    running_thread_count_ = threads_.size();
+    ++generation_;
+  }
+  start_condition_.notify_all();
+  run();
+  std::unique_lock<std::mutex> lock(mutex_);
+  finish_condition_.wait(lock, [this]() { return running_thread_count_ == 0; });
+  function_ = nullptr;
+  if (thrown_) {
+    std::rethrow_exception(std::exchange(thrown_, nullptr));
+  }
+}
+
+auto ThreadPool::work() -> void
+{
+  std::size_t generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_condition_.wait(
+        lock, [&]() { return is_stop_requested_ or generation_ != generation; });
+      if (is_stop_requested_) {
+        return;
+      }
+      generation = generation_;
+    }
+    run();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--running_thread_count_ == 0) {
+        finish_condition_.notify_one();
+      }
+    }
+  }
+}
+
+auto ThreadPool::run() -> void
+{
+  for (auto index = next_index_++; index < size_; index = next_index_++) {
+    try {
+      (*function_)(index);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (not thrown_ or index < thrown_index_) {
+        thrown_ = std::current_exception();
+        thrown_index_ = index;
+      }
+    }
+  }
+}
+}  // namespace helper
+}  // namespace traffic_simulator
@@ -14,6 +14,7 @@
 
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <traffic_simulator/traffic_lights/traffic_light_manager.hpp>
 #include <type_traits>
@@ -39,6 +40,7 @@ auto TrafficLightManager::hasAnyLightChanged() -> bool
 
 auto TrafficLightManager::getTrafficLight(const LaneletID traffic_light_id) -> TrafficLight &
 {
+  std::lock_guard<std::mutex> lock(traffic_lights_mutex_);
   if (auto iter = traffic_lights_.find(traffic_light_id); iter != std::end(traffic_lights_)) {
     return iter->second;
   } else {
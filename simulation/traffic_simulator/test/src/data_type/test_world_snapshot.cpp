@@ -0,0 +1,157 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <scenario_simulator_exception/exception.hpp>
+#include <string>
+#include <traffic_simulator/data_type/world_snapshot.hpp>
+#include <vector>
+
+/// @note Entity i gets the id 2 * i, as if the entities with odd ids had been despawned.
+auto makeWorldSnapshot(const std::vector<std::string> & names)
+  -> std::shared_ptr<const traffic_simulator::WorldSnapshot>
+{
+  auto snapshot = std::make_shared<traffic_simulator::WorldSnapshot>();
+  for (const auto & name : names) {
+    const traffic_simulator::EntityId id = 2 * snapshot->size();
+    traffic_simulator::EntityStatus status;
+    status.name = name;
+    status.pose.position.x = static_cast<double>(id);
+    snapshot->emplace(id, name, traffic_simulator::CanonicalizedEntityStatus(status, nullptr));
+  }
+  return snapshot;
+}
+
+TEST(WorldSnapshot, IndexedByEntityId)
+{
+  const auto snapshot = makeWorldSnapshot({"ego", "npc1", "npc2"});
+  EXPECT_EQ(snapshot->size(), static_cast<std::size_t>(3));
+  EXPECT_EQ(snapshot->getIds(), (std::vector<traffic_simulator::EntityId>{0, 2, 4}));
+  for (const auto id : snapshot->getIds()) {
+    EXPECT_TRUE(snapshot->contains(id));
+    EXPECT_EQ(snapshot->findId(snapshot->getName(id)), id);
+    EXPECT_DOUBLE_EQ(snapshot->getStatus(id).getMapPose().position.x, static_cast<double>(id));
+  }
+  for (const traffic_simulator::EntityId id : {1, 3, 5}) {
+    EXPECT_FALSE(snapshot->contains(id));
+    EXPECT_THROW(snapshot->getName(id), common::SimulationError);
+    EXPECT_THROW(snapshot->getStatus(id), common::SimulationError);
+  }
+  EXPECT_FALSE(snapshot->findId("npc3"));
+  const auto mutable_snapshot = std::const_pointer_cast<traffic_simulator::WorldSnapshot>(snapshot);
+  EXPECT_THROW(
+    mutable_snapshot->emplace(1, "npc1", snapshot->getStatus(0)), common::SimulationError);
+  EXPECT_THROW(
+    mutable_snapshot->emplace(2, "npc3", snapshot->getStatus(0)), common::SimulationError);
+  mutable_snapshot->emplace(1, "npc3", snapshot->getStatus(0));
+  EXPECT_EQ(snapshot->getIds(), (std::vector<traffic_simulator::EntityId>{0, 1, 2, 4}));
+  EXPECT_EQ(snapshot->findId("npc3"), static_cast<traffic_simulator::EntityId>(1));
+}
+
+TEST(WorldSnapshotView, ExcludesOwnEntity)
+{
+  const auto snapshot = makeWorldSnapshot({"ego", "npc1", "npc2"});
+  for (const auto & excluded_name : {"ego", "npc1", "npc2"}) {
+    const auto view = traffic_simulator::WorldSnapshotView(snapshot, excluded_name);
+    EXPECT_EQ(view.size(), static_cast<std::size_t>(2));
+    EXPECT_TRUE(view.find(excluded_name) == view.end());
+    EXPECT_EQ(view.count(excluded_name), static_cast<std::size_t>(0));
+    EXPECT_THROW(view.at(excluded_name), common::SimulationError);
+    std::vector<std::string> names;
+    for (const auto & [name, status] : view) {
+      names.push_back(name);
+      EXPECT_DOUBLE_EQ(
+        status.getMapPose().position.x, static_cast<double>(snapshot->findId(name).value()));
+    }
+    EXPECT_EQ(names.size(), static_cast<std::size_t>(2));
+    for (const auto & name : names) {
+      EXPECT_NE(name, excluded_name);
+      EXPECT_EQ(view.find(name)->first, name);
+      EXPECT_EQ(view.count(name), static_cast<std::size_t>(1));
+    }
+  }
+}
+
+TEST(WorldSnapshot, NeighbourQueries)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position(-500.0, 500.0);
+  const std::vector<std::int64_t> lanelet_ids = {34411, 34513, 120659};
+  const auto hdmap_utils = std::make_shared<hdmap_utils::HdMapUtils>(
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm",
+    geographic_msgs::msg::GeoPoint());
+  auto snapshot = std::make_shared<traffic_simulator::WorldSnapshot>();
+  for (traffic_simulator::EntityId i = 0; i < 300; ++i) {
+    traffic_simulator::EntityStatus status;
+    status.name = "npc" + std::to_string(i);
+    status.pose.position.x = position(engine);
+    status.pose.position.y = position(engine);
+    status.bounding_box.dimensions.x = 4.0;
+    status.bounding_box.dimensions.y = 2.0;
+    status.lanelet_pose_valid = i % 3 != 0;
+    status.lanelet_pose.lanelet_id = lanelet_ids[i % lanelet_ids.size()];
+    status.lanelet_pose.s = 1.0;
+    snapshot->emplace(
+      3 * i, status.name, traffic_simulator::CanonicalizedEntityStatus(status, hdmap_utils));
+  }
+  for (const auto id : lanelet_ids) {
+    std::vector<traffic_simulator::EntityId> expected;
+    for (const auto i : snapshot->getIds()) {
+      if (
+        snapshot->getStatus(i).laneMatchingSucceed() and
+        snapshot->getStatus(i).getLaneletPose().lanelet_id == id) {
+        expected.push_back(i);
+      }
+    }
+    EXPECT_EQ(snapshot->getIdsOnLanelet(id), expected);
+  }
+  const double bounding_radius = std::hypot(2.0, 1.0);
+  for (const double distance : {0.0, 10.0, 40.0, 120.0, 2000.0}) {
+    geometry_msgs::msg::Point point;
+    point.x = position(engine);
+    point.y = position(engine);
+    const auto ids = snapshot->getIdsWithin(point, distance);
+    std::vector<traffic_simulator::EntityId> expected;
+    for (const auto i : snapshot->getIds()) {
+      const auto p = snapshot->getStatus(i).getMapPose().position;
+      if (std::hypot(p.x - point.x, p.y - point.y) <= distance + bounding_radius) {
+        expected.push_back(i);
+      }
+    }
+    EXPECT_EQ(ids, expected);
+    const auto view = traffic_simulator::WorldSnapshotView(snapshot, "npc1");
+    for (const auto id : view.getIdsWithin(point, distance)) {
+      EXPECT_NE(view.getName(id), "npc1");
+    }
+  }
+}
+
+TEST(WorldSnapshotView, Empty)
+{
+  const auto view = traffic_simulator::WorldSnapshotView();
+  EXPECT_TRUE(view.empty());
+  EXPECT_TRUE(view.begin() == view.end());
+  EXPECT_TRUE(view.find("ego") == view.end());
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,168 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <memory>
+#include <rclcpp/rclcpp.hpp>
+#include <scenario_simulator_exception/exception.hpp>
+#include <string>
+#include <traffic_simulator/entity/entity_manager.hpp>
+#include <traffic_simulator/helper/helper.hpp>
+#include <utility>
+#include <vector>
+
+#include "../catalogs.hpp"
+
+auto makeConfiguration(std::size_t npc_logic_thread_count) -> traffic_simulator::Configuration
+{
+  const auto map_path =
+    boost::filesystem::temp_directory_path() / "traffic_simulator_test_entity_manager";
+  boost::filesystem::create_directories(map_path);
+  if (const auto lanelet2_map_file = map_path / "lanelet2_map.osm";
+      not boost::filesystem::exists(lanelet2_map_file)) {
+    boost::filesystem::copy_file(
+      ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm",
+      lanelet2_map_file);
+  }
+  /// @note Configuration requires a point cloud map, but EntityManager never reads it.
+  std::ofstream((map_path / "pointcloud_map.pcd").string(), std::ios::app);
+  auto configuration = traffic_simulator::Configuration(map_path);
+  configuration.npc_logic_thread_count = npc_logic_thread_count;
+  return configuration;
+}
+
+auto spawnVehicle(
+  traffic_simulator::entity::EntityManager & entity_manager, const std::string & name,
+  std::int64_t lanelet_id = 34513, double s = 0.0) -> void
+{
+  entity_manager.spawnEntity<traffic_simulator::entity::VehicleEntity>(
+    name,
+    traffic_simulator::CanonicalizedLaneletPose(
+      traffic_simulator::helper::constructLaneletPose(lanelet_id, s, 0),
+      entity_manager.getHdmapUtils()),
+    getVehicleParameters());
+}
+
+/**
+ * @brief Runs the same multi-NPC scenario and returns the status of every entity in every frame.
+ */
+auto simulate(std::size_t npc_logic_thread_count)
+  -> std::vector<traffic_simulator::EntityStatus>
+{
+  const auto node = std::make_shared<rclcpp::Node>(
+    "test_entity_manager_" + std::to_string(npc_logic_thread_count), rclcpp::NodeOptions());
+  traffic_simulator::entity::EntityManager entity_manager(
+    node, makeConfiguration(npc_logic_thread_count));
+
+  /// @note Vehicles on the same lanelet follow each other, so NPC logic reads other entities.
+  const std::vector<std::pair<std::int64_t, double>> lanelet_positions = {
+    {34513, 0.0}, {34513, 7.0}, {34513, 14.0}, {34513, 21.0}, {34513, 28.0}, {120659, 1.0}};
+  std::vector<std::string> names;
+  for (const auto & [lanelet_id, s] : lanelet_positions) {
+    const auto name = "npc" + std::to_string(names.size());
+    spawnVehicle(entity_manager, name, lanelet_id, s);
+    entity_manager.requestSpeedChange(name, 5.0 + static_cast<double>(names.size()), true);
+    names.push_back(name);
+  }
+  entity_manager.startNpcLogic();
+
+  constexpr double step_time = 0.05;
+  std::vector<traffic_simulator::EntityStatus> statuses;
+  for (int frame = 0; frame < 100; ++frame) {
+    entity_manager.update(frame * step_time, step_time);
+    for (const auto & name : names) {
+      statuses.push_back(
+        static_cast<traffic_simulator::EntityStatus>(entity_manager.getEntityStatus(name)));
+    }
+  }
+  return statuses;
+}
+
+TEST(EntityManager, ParallelNpcLogicMatchesSerial)
+{
+  const auto serial = simulate(1);
+  const auto parallel = simulate(4);
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (std::size_t i = 0; i < serial.size(); ++i) {
+    EXPECT_TRUE(serial[i] == parallel[i]) << "status of " << serial[i].name << " at index " << i;
+  }
+}
+
+TEST(EntityManager, EntityIdAndName)
+{
+  const auto node = std::make_shared<rclcpp::Node>("test_entity_id_and_name");
+  traffic_simulator::entity::EntityManager entity_manager(node, makeConfiguration(0));
+  for (const auto & name : {"npc0", "npc1", "npc2"}) {
+    spawnVehicle(entity_manager, name);
+  }
+  for (const auto & name : {"npc0", "npc1", "npc2"}) {
+    EXPECT_EQ(entity_manager.getEntityName(entity_manager.getEntityId(name)), name);
+  }
+  EXPECT_EQ(entity_manager.getEntityId("npc0"), static_cast<traffic_simulator::EntityId>(0));
+  EXPECT_EQ(entity_manager.getEntityId("npc2"), static_cast<traffic_simulator::EntityId>(2));
+  EXPECT_THROW(entity_manager.getEntityId("npc3"), common::SemanticError);
+  EXPECT_THROW(entity_manager.getEntityName(3), common::SemanticError);
+  EXPECT_THROW(spawnVehicle(entity_manager, "npc1"), common::SemanticError);
+  /// @note Unknown names are semantic errors of the scenario, not std::out_of_range.
+  EXPECT_THROW(entity_manager.isEgo("npc3"), common::SemanticError);
+  EXPECT_THROW(entity_manager.requestSpeedChange("npc3", 1.0, false), common::SemanticError);
+  EXPECT_THROW(entity_manager.getCurrentTwist("npc3"), common::SemanticError);
+}
+
+TEST(EntityManager, RespawnReusesEntityId)
+{
+  const auto node = std::make_shared<rclcpp::Node>("test_respawn_reuses_entity_id");
+  traffic_simulator::entity::EntityManager entity_manager(node, makeConfiguration(0));
+  for (const auto & name : {"npc0", "npc1", "npc2"}) {
+    spawnVehicle(entity_manager, name);
+  }
+  EXPECT_TRUE(entity_manager.despawnEntity("npc1"));
+  EXPECT_FALSE(entity_manager.despawnEntity("npc1"));
+  EXPECT_FALSE(entity_manager.entityExists("npc1"));
+  EXPECT_THROW(entity_manager.getEntityId("npc1"), common::SemanticError);
+  EXPECT_THROW(entity_manager.getEntityName(1), common::SemanticError);
+  EXPECT_EQ(entity_manager.getEntityId("npc2"), static_cast<traffic_simulator::EntityId>(2));
+  entity_manager.update(0.0, 0.05);
+
+  spawnVehicle(entity_manager, "npc3");
+  EXPECT_EQ(entity_manager.getEntityId("npc3"), static_cast<traffic_simulator::EntityId>(1));
+  EXPECT_EQ(entity_manager.getEntityName(1), "npc3");
+  spawnVehicle(entity_manager, "npc4");
+  EXPECT_EQ(entity_manager.getEntityId("npc4"), static_cast<traffic_simulator::EntityId>(3));
+
+  /// @note Respawning under a despawned name works like spawning any other entity.
+  EXPECT_TRUE(entity_manager.despawnEntity("npc0"));
+  spawnVehicle(entity_manager, "npc1", 120659, 1.0);
+  EXPECT_EQ(entity_manager.getEntityId("npc1"), static_cast<traffic_simulator::EntityId>(0));
+  EXPECT_EQ(entity_manager.getEntityStatus("npc1").getLaneletPose().lanelet_id, 120659);
+  EXPECT_FALSE(entity_manager.entityExists("npc0"));
+  entity_manager.update(0.05, 0.05);
+  EXPECT_EQ(entity_manager.getEntityNames().size(), static_cast<std::size_t>(4));
+  for (const auto & name : {"npc1", "npc2", "npc3", "npc4"}) {
+    EXPECT_EQ(entity_manager.getEntityName(entity_manager.getEntityId(name)), name);
+    EXPECT_EQ(
+      static_cast<traffic_simulator::EntityStatus>(entity_manager.getEntityStatus(name)).name, name);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,72 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <traffic_simulator/helper/thread_pool.hpp>
+#include <vector>
+
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnce)
+{
+  traffic_simulator::helper::ThreadPool thread_pool(3);
+  EXPECT_EQ(thread_pool.getThreadCount(), static_cast<std::size_t>(3));
+  for (std::size_t size : {0, 1, 2, 7, 1000}) {
+    std::vector<int> counts(size, 0);
+    thread_pool.parallelFor(size, [&](std::size_t i) { ++counts[i]; });
+    for (const auto count : counts) {
+      EXPECT_EQ(count, 1);
+    }
+  }
+}
+
+TEST(ThreadPool, ParallelForWithoutWorkerThreads)
+{
+  traffic_simulator::helper::ThreadPool thread_pool(0);
+  std::vector<int> counts(10, 0);
+  thread_pool.parallelFor(counts.size(), [&](std::size_t i) { ++counts[i]; });
+  for (const auto count : counts) {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+TEST(ThreadPool, ParallelForRethrowsExceptionOfSmallestIndex)
+{
+  traffic_simulator::helper::ThreadPool thread_pool(3);
+  for (int trial = 0; trial < 100; ++trial) {
+    try {
+      thread_pool.parallelFor(100, [](std::size_t i) {
+        if (i % 10 == 3) {
+          throw std::runtime_error(std::to_string(i));
+        }
+      });
+      FAIL() << "exception is not rethrown";
+    } catch (const std::runtime_error & error) {
+      EXPECT_STREQ(error.what(), "3");
+    }
+  }
+  /// @note The pool must stay usable after an exception.
+  std::vector<int> counts(10, 0);
+  thread_pool.parallelFor(counts.size(), [&](std::size_t i) { ++counts[i]; });
+  for (const auto count : counts) {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -313,6 +313,23 @@ TEST(HdMapUtils, CanonicalizeAll)
   EXPECT_EQ(canonicalized_lanelet_poses[0].s, non_canonicalized_lanelet_s);
 }
 
+TEST(HdMapUtils, GetLineStrings)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+
+  const auto stop_lines = hdmap_utils.getLineStrings("stop_line");
+  EXPECT_EQ(stop_lines.size(), static_cast<long unsigned int>(2));
+  for (const auto & stop_line : stop_lines) {
+    EXPECT_EQ(stop_line.size(), static_cast<long unsigned int>(2));
+  }
+  EXPECT_TRUE(hdmap_utils.getLineStrings("wall").empty());
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);